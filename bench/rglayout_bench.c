@@ -0,0 +1,687 @@
+// Headless layout microbenchmark
+//
+// Times Begin/Rec/End throughput without a window (RGLAYOUT_STANDALONE).
+// Output is CSV on stdout, one line per benchmark, so results can be diffed
+// between releases:
+//
+//   benchmark,iterations,rects,ns_per_rect,ns_per_iter,checksum
+//
+// The checksum is a sum over every produced rectangle; it should only change
+// when layout results change, not when the code gets faster or slower.
+//
+// Usage: rglayout-bench [iterations]
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L // Required for: clock_gettime()
+#endif
+
+#define RGLAYOUT_IMPLEMENTATION
+#include "rglayout.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+// Avoid windows.h, it conflicts with raylib-style names (Rectangle, CloseWindow...)
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *freq);
+#else
+#include <time.h>
+#endif
+
+//----------------------------------------------------------------------------------
+// Timing helpers
+//----------------------------------------------------------------------------------
+
+static double bench_now_ns(void)
+{
+#if defined(_WIN32)
+    long long count = 0, freq = 1;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (double)count*1e9/(double)freq;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec*1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+// Accumulated over every produced rect so the optimizer can't drop layout work
+static double g_checksum = 0.0;
+
+static void sink(Rectangle r)
+{
+    g_checksum += r.x + r.y + r.width + r.height;
+}
+
+//----------------------------------------------------------------------------------
+// Benchmarks (each returns the number of rects produced per iteration)
+//----------------------------------------------------------------------------------
+
+static const Rectangle SCREEN = { 0, 0, 1920, 1080 };
+
+// Column/Row containers nested RGL_MAX_STACK deep, two leaf rects per level
+static int bench_deep_nesting(void)
+{
+    int rects = 0;
+
+    for (int i = 0; i < RGL_MAX_STACK; i++)
+    {
+        Rectangle bounds = (i == 0)? SCREEN : GuiLayoutRec(-1, -1);
+        if (i > 0) rects++;
+
+        if (i%2 == 0) GuiBeginColumn(bounds, NULL);
+        else GuiBeginRow(bounds, NULL);
+
+        sink(GuiLayoutRec(20, -1));
+        rects++;
+    }
+
+    for (int i = 0; i < RGL_MAX_STACK; i++) GuiLayoutEnd();
+
+    return rects;
+}
+
+// 256 levels of nesting, the stack grows into a frame arena that is reset every iteration
+#define DEEP_LEVELS 256
+static unsigned char g_arena_memory[1 << 16];
+static RGLArena g_arena = { 0 };
+
+static int bench_deep_nesting_arena(void)
+{
+    int rects = 0;
+
+    RGLSetArena(&g_arena);
+    RGLBeginFrame();
+    for (int i = 0; i < DEEP_LEVELS; i++)
+    {
+        Rectangle bounds = (i == 0)? SCREEN : GuiLayoutRec(-1, -1);
+        if (i > 0) rects++;
+
+        if (i%2 == 0) GuiBeginColumnEx(bounds, RGL_PAD_0, 0, NULL);
+        else GuiBeginRowEx(bounds, RGL_PAD_0, 0, NULL);
+
+        sink(GuiLayoutRec(2, -1));
+        rects++;
+    }
+
+    for (int i = 0; i < DEEP_LEVELS; i++) GuiLayoutEnd();
+    RGLSetArena(NULL);
+
+    return rects;
+}
+
+// One row with a full RGL_PLAN_MAX plan mixing fixed pixels and flex weights
+static int bench_wide_plan(void)
+{
+    RGLPlan plan = GuiPlanCreate(NULL, 0);
+    for (int i = 0; i < RGL_PLAN_MAX; i++) GuiPlanAdd(&plan, (i%4 == 0)? 40.0f : (float)(1 + i%3));
+
+    GuiBeginRow(SCREEN, &plan);
+    for (int i = 0; i < RGL_PLAN_MAX; i++) sink(GuiLayoutRec(-1, -1));
+    GuiLayoutEnd();
+
+    return RGL_PLAN_MAX;
+}
+
+// Same row as wide_plan with a compile-time plan (nothing built per iteration)
+RGL_PLAN_DEFINE(g_wide_plan, 40, 2, 3, 1, 40, 3, 1, 2, 40, 1, 2, 3, 40, 2, 3, 1, 40, 3, 1, 2, 40, 1, 2, 3, 40, 2, 3, 1, 40, 3, 1, 2);
+
+static int bench_wide_plan_static(void)
+{
+    GuiBeginRow(SCREEN, &g_wide_plan);
+    for (int i = 0; i < g_wide_plan.length; i++) sink(GuiLayoutRec(-1, -1));
+    GuiLayoutEnd();
+
+    return g_wide_plan.length;
+}
+
+// Same row as wide_plan, all children emitted by one GuiLayoutRecN call
+static int bench_wide_plan_batch(void)
+{
+    float x[RGL_PLAN_MAX], y[RGL_PLAN_MAX], w[RGL_PLAN_MAX], h[RGL_PLAN_MAX];
+    RGLPlan plan = GuiPlanCreate(NULL, 0);
+    for (int i = 0; i < RGL_PLAN_MAX; i++) GuiPlanAdd(&plan, (i%4 == 0)? 40.0f : (float)(1 + i%3));
+
+    GuiBeginRow(SCREEN, &plan);
+    GuiLayoutRecN(RGL_PLAN_MAX, -1, -1, x, y, w, h);
+    GuiLayoutEnd();
+
+    for (int i = 0; i < RGL_PLAN_MAX; i++) sink((Rectangle){ x[i], y[i], w[i], h[i] });
+
+    return RGL_PLAN_MAX;
+}
+
+// Same row as wide_plan_static with every rect also appended to a command buffer
+static RGLCommand g_commands[RGL_PLAN_MAX];
+static RGLCommandBuffer g_command_buffer = { 0 };
+
+static int bench_wide_plan_commands(void)
+{
+    RGLCommandBufferReset(&g_command_buffer);
+    RGLSetCommandBuffer(&g_command_buffer);
+
+    GuiBeginRow(SCREEN, &g_wide_plan);
+    for (int i = 0; i < g_wide_plan.length; i++)
+    {
+        GuiLayoutSetNextTag((unsigned int)(i%4));
+        GuiLayoutRec(-1, -1);
+    }
+    GuiLayoutEnd();
+
+    RGLSetCommandBuffer(NULL);
+    for (int i = 0; i < g_command_buffer.count; i++) sink(g_command_buffer.commands[i].rect);
+
+    return g_command_buffer.count;
+}
+
+// Data grid header: one row with a 1000-entry plan built in the frame arena every iteration
+#define GRID_COLUMNS 1000
+
+static int bench_wide_plan_arena(void)
+{
+    RGLSetArena(&g_arena);
+    RGLBeginFrame();
+
+    RGLPlan plan = GuiPlanCreateArena(&g_arena, GRID_COLUMNS);
+    for (int i = 0; i < GRID_COLUMNS; i++) GuiPlanAdd(&plan, (i%4 == 0)? 40.0f : (float)(1 + i%3));
+
+    GuiBeginRow(SCREEN, &plan);
+    for (int i = 0; i < GRID_COLUMNS; i++) sink(GuiLayoutRec(-1, -1));
+    GuiLayoutEnd();
+    RGLSetArena(NULL);
+
+    return GRID_COLUMNS;
+}
+
+// Ad-hoc mode (no plan): a column of rows, fixed-size cells and a fill cell
+static int bench_adhoc(void)
+{
+    int rects = 0;
+
+    GuiBeginColumn(SCREEN, NULL);
+    for (int row = 0; row < 32; row++)
+    {
+        GuiBeginRow(GuiLayoutRec(30, -1), NULL);
+        for (int i = 0; i < 15; i++) sink(GuiLayoutRec(60, -1));
+        sink(GuiLayoutRec(-1, -1));
+        GuiLayoutEnd();
+        rects += 17;
+    }
+    GuiLayoutEnd();
+
+    return rects;
+}
+
+// Thumbnail gallery: 32x32 grid, every cell fetched in row-major order
+static int bench_grid(void)
+{
+    RGLPlan cols = GuiPlanCreate(NULL, 0);
+    GuiPlanAddRepeat(&cols, 1.0f, 32);
+
+    GuiBeginGrid(SCREEN, &cols, &cols);
+    for (int i = 0; i < 32*32; i++) sink(GuiLayoutRec(-1, -1));
+    GuiLayoutEnd();
+
+    return 32*32;
+}
+
+// Tag cloud: 512 chips of varying width wrapping inside a flow container
+static int bench_flow(void)
+{
+    GuiBeginFlow(SCREEN, 24.0f);
+    for (int i = 0; i < 512; i++) sink(GuiLayoutRec(40.0f + (float)((i*37)%90), -1));
+    sink(GuiLayoutContentSize());
+    GuiLayoutEnd();
+
+    return 512;
+}
+
+// Rows whose plans are all flex weights (and -1 fills), rebuilt every frame
+static int bench_flex_heavy_rows(bool cached)
+{
+    int rects = 0;
+
+    GuiBeginColumn(SCREEN, NULL);
+    for (int row = 0; row < 16; row++)
+    {
+        RGLPlan plan = GuiPlanCreate(NULL, 0);
+        for (int i = 0; i < RGL_PLAN_MAX; i++) GuiPlanAdd(&plan, (i%5 == 0)? -1.0f : (float)(1 + (i + row)%4));
+
+        if (cached) GuiLayoutSetNextId(100 + row);
+        GuiBeginRow(GuiLayoutRec(-1, -1), &plan);
+        for (int i = 0; i < RGL_PLAN_MAX; i++) sink(GuiLayoutRec(-1, -1));
+        GuiLayoutEnd();
+        rects += RGL_PLAN_MAX + 1;
+    }
+    GuiLayoutEnd();
+
+    return rects;
+}
+
+static int bench_flex_heavy(void)
+{
+    return bench_flex_heavy_rows(false);
+}
+
+// Same layout as flex_heavy with the layout cache enabled (steady state: every row hits)
+static RGLLayoutCache g_cache = { 0 };
+
+static int bench_flex_heavy_cached(void)
+{
+    RGLSetLayoutCache(&g_cache);
+    int rects = bench_flex_heavy_rows(true);
+    RGLSetLayoutCache(NULL);
+
+    return rects;
+}
+
+// Rows picking phone/tablet/desktop plans from a breakpoint table by width (desktop at SCREEN)
+RGL_PLAN_DEFINE(g_phone_plan, -1, 2);
+RGL_PLAN_DEFINE(g_tablet_plan, 1, 2, 2, 1, -1, 40, 40, 1);
+RGL_PLAN_DEFINE(g_desktop_plan, 1, 2, 3, 4, -1, 1, 2, 3, 4, -1, 1, 2, 3, 4, -1, 1,
+                                 2, 3, 4, -1, 1, 2, 3, 4, -1, 1, 2, 3, 4, -1, 1, 2);
+static const RGLBreakpoint BREAKPOINTS[] = { { 0, &g_phone_plan }, { 600, &g_tablet_plan }, { 1200, &g_desktop_plan } };
+
+static int bench_responsive_rows(bool cached)
+{
+    int rects = 0;
+
+    GuiBeginColumn(SCREEN, NULL);
+    for (int row = 0; row < 16; row++)
+    {
+        if (cached) GuiLayoutSetNextId(200 + row);
+        GuiBeginRowResponsive(GuiLayoutRec(-1, -1), BREAKPOINTS, 3);
+        for (int i = 0; i < g_desktop_plan.length; i++) sink(GuiLayoutRec(-1, -1));
+        GuiLayoutEnd();
+        rects += g_desktop_plan.length + 1;
+    }
+    GuiLayoutEnd();
+
+    return rects;
+}
+
+static int bench_responsive(void)
+{
+    return bench_responsive_rows(false);
+}
+
+// Same layout with the layout cache enabled (steady state: selection and spans are reused)
+static int bench_responsive_cached(void)
+{
+    RGLSetLayoutCache(&g_cache);
+    int rects = bench_responsive_rows(true);
+    RGLSetLayoutCache(NULL);
+
+    return rects;
+}
+
+// Virtualized list of 1M uniform rows, scrolled a little further every iteration
+#define SCROLL_ITEMS 1000000
+
+static int bench_scroll_uniform(void)
+{
+    static float scroll = 0;
+    scroll = (scroll > 1.0e7f)? 0 : scroll + 97.0f;
+
+    RGLRange range = GuiBeginScrollColumn(SCREEN, scroll, SCROLL_ITEMS, 18.0f);
+    for (int i = 0; i < range.count; i++) sink(GuiLayoutRec(-1, -1));
+    GuiLayoutEnd();
+
+    return range.count;
+}
+
+// Virtualized list of 1M variable rows through a prefix-sum index (built once in main)
+static RGLScrollIndex g_scroll_index = { 0 };
+
+static float scroll_item_size_cb(int index, void *user)
+{
+    (void)user;
+    return (float)(12 + ((index%30)*7919)%30); // Reduced first, index*7919 overflows int past 271182
+}
+
+static int bench_scroll_variable(void)
+{
+    static float scroll = 0;
+    scroll = (scroll > 1.0e7f)? 0 : scroll + 97.0f;
+
+    RGLRange range = GuiBeginScrollColumnEx(SCREEN, RGLPadAll(2), 4, scroll, SCROLL_ITEMS, 0, &g_scroll_index);
+    for (int i = 0; i < range.count; i++) sink(GuiLayoutRec(-1, -1));
+    GuiLayoutEnd();
+
+    return range.count;
+}
+
+// Deferred tree: record a column of fit-content rows with fill cells, then measure + arrange
+#define TREE_NODES 1024
+static RGLNode g_tree_nodes[TREE_NODES];
+
+static int bench_tree_solve(void)
+{
+    RGLTree tree;
+    RGLTreeBegin(&tree, g_tree_nodes, TREE_NODES);
+
+    RGLTreeBeginColumn(&tree, -1, -1);
+    for (int row = 0; row < 32; row++)
+    {
+        RGLTreeBeginRow(&tree, RGL_FIT, -1);
+        for (int i = 0; i < 15; i++) RGLTreeRecContent(&tree, (i%3 == 0)? -1 : RGL_FIT, RGL_FIT, 40.0f + i, 20.0f + row%4);
+        RGLTreeRec(&tree, -1, -1);
+        RGLTreeEnd(&tree);
+    }
+    RGLTreeEnd(&tree);
+
+    RGLTreeSolve(&tree, SCREEN);
+    for (int i = 0; i < tree.count; i++) sink(RGLTreeRect(&tree, i));
+
+    return tree.count;
+}
+
+// Large dashboard tree (64 independent panels, ~50k nodes) recorded once in main, solved every iteration
+#define DASH_NODES 65536
+static RGLNode *g_dash_nodes = NULL;
+static RGLTree g_dash_tree = { 0 };
+static RGLThreadPool g_pool = { 0 };
+
+static void record_dashboard(void)
+{
+    RGLTreeBegin(&g_dash_tree, g_dash_nodes, DASH_NODES);
+    RGLTreeBeginRow(&g_dash_tree, -1, -1);
+    for (int panel = 0; panel < 64; panel++)
+    {
+        RGLTreeBeginColumn(&g_dash_tree, -1, -1);
+        for (int row = 0; row < 60; row++)
+        {
+            RGLTreeBeginRow(&g_dash_tree, RGL_FIT, -1);
+            for (int i = 0; i < 11; i++) RGLTreeRecContent(&g_dash_tree, (i%4 == 0)? -1 : RGL_FIT, RGL_FIT, 8.0f + i, 10.0f);
+            RGLTreeEnd(&g_dash_tree);
+        }
+        RGLTreeEnd(&g_dash_tree);
+    }
+    RGLTreeEnd(&g_dash_tree);
+}
+
+static int bench_tree_large_serial(void)
+{
+    RGLTreeSolve(&g_dash_tree, SCREEN);
+    sink(RGLTreeRect(&g_dash_tree, g_dash_tree.count - 1));
+    return g_dash_tree.count;
+}
+
+static int bench_tree_large_parallel(void)
+{
+    RGLTreeSolveParallel(&g_dash_tree, SCREEN, &g_pool);
+    sink(RGLTreeRect(&g_dash_tree, g_dash_tree.count - 1));
+    return g_dash_tree.count;
+}
+
+// Editor tree: fixed-width side panels around a flex center column, solved at alternating window
+// widths (a drag resize). The incremental solve only re-arranges the root and the center column
+#define EDITOR_NODES 4096
+static RGLNode g_editor_nodes[EDITOR_NODES];
+static RGLTree g_editor_tree = { 0 };
+static int g_editor_frame = 0;
+
+static void record_editor_panel(float width, int rows)
+{
+    RGLTreeBeginColumn(&g_editor_tree, width, -1);
+    for (int row = 0; row < rows; row++)
+    {
+        RGLTreeBeginRow(&g_editor_tree, 20, -1);
+        for (int i = 0; i < 10; i++) RGLTreeRec(&g_editor_tree, (i == 0)? -1 : 24, -1);
+        RGLTreeEnd(&g_editor_tree);
+    }
+    RGLTreeEnd(&g_editor_tree);
+}
+
+static void record_editor(void)
+{
+    RGLTreeBegin(&g_editor_tree, g_editor_nodes, EDITOR_NODES);
+    RGLTreeBeginRow(&g_editor_tree, -1, -1);
+    record_editor_panel(320, 40);
+    record_editor_panel(-1, 8);
+    record_editor_panel(320, 40);
+    RGLTreeEnd(&g_editor_tree);
+}
+
+static Rectangle editor_bounds(void)
+{
+    g_editor_frame++;
+    return (Rectangle){ 0, 0, (g_editor_frame & 1)? 1920.0f : 1880.0f, 1080 };
+}
+
+static int bench_tree_resize(void)
+{
+    RGLTreeSolve(&g_editor_tree, editor_bounds());
+    sink(RGLTreeRect(&g_editor_tree, g_editor_tree.count - 1));
+    return g_editor_tree.count;
+}
+
+static int bench_tree_resize_incremental(void)
+{
+    RGLTreeSolveIncremental(&g_editor_tree, editor_bounds());
+    sink(RGLTreeRect(&g_editor_tree, g_editor_tree.count - 1));
+    return g_editor_tree.count;
+}
+
+// Text-fit labels: a form of 32 labels sized by GuiLayoutRecText in a flow. The glyph metric looks
+// glyphs up with a linear search over 95 entries, like raylib's GetGlyphIndex() on a loaded font
+static const char *LABELS[] = {
+    "Username:", "Password:", "Remember me", "Sign in", "Forgot password?", "Create account", "Email address",
+    "First name", "Last name", "Street", "City", "Postal code", "Country", "Phone", "Company", "Website",
+    "Save", "Cancel", "Apply", "Reset to defaults", "Advanced settings", "Language", "Theme", "Font size",
+    "Notifications", "Privacy", "Security", "Two-factor authentication", "Sessions", "Log out", "Help", "About",
+};
+static float g_glyph_advance[95];
+static int g_glyph_value[95];
+static RGLTextCache g_text_cache = { 0 };
+
+static float bench_glyph_advance(int codepoint, const void *font, float size, void *user)
+{
+    (void)font; (void)user;
+    int index = 0;
+    for (int i = 0; i < 95; i++) if (g_glyph_value[i] == codepoint) { index = i; break; }
+    return g_glyph_advance[index]*size/10.0f;
+}
+
+static int bench_text_fit_labels(bool cached)
+{
+    RGLSetTextMeasure(bench_glyph_advance, NULL);
+    RGLSetTextCache(cached? &g_text_cache : NULL);
+
+    GuiBeginFlow(SCREEN, 24);
+    for (int i = 0; i < 32; i++) sink(GuiLayoutRecText(LABELS[i], 4, -1));
+    GuiLayoutEnd();
+
+    RGLSetTextCache(NULL);
+    RGLSetTextMeasure(NULL, NULL);
+
+    return 32;
+}
+
+static int bench_text_fit(void)
+{
+    return bench_text_fit_labels(false);
+}
+
+static int bench_text_fit_cached(void)
+{
+    return bench_text_fit_labels(true);
+}
+
+// Hit testing: a 32x32 grid of cells with a row of 16 widgets each (~17k rects) recorded once in main,
+// every iteration finds the widget under 256 points (the rects column counts queries)
+#define HIT_ENTRIES 32768
+static RGLHitEntry *g_hit_entries = NULL;
+static int *g_hit_children = NULL;
+static RGLHitIndex g_hit = { 0 };
+
+static void record_hit_layout(void)
+{
+    RGLPlan tracks = GuiPlanCreate(NULL, 0);
+    GuiPlanAddRepeat(&tracks, 1.0f, 32);
+
+    RGLHitIndexInit(&g_hit, g_hit_entries, g_hit_children, HIT_ENTRIES);
+    RGLSetHitIndex(&g_hit);
+    RGLBeginFrame();
+
+    GuiBeginGrid(SCREEN, &tracks, &tracks);
+    for (int i = 0; i < 32*32; i++)
+    {
+        GuiBeginRowEx(GuiLayoutRec(-1, -1), RGL_PAD_0, 0, NULL);
+        for (int w = 0; w < 16; w++)
+        {
+            GuiLayoutSetNextTag((unsigned int)(i*16 + w + 1));
+            GuiLayoutRec(3, -1);
+        }
+        GuiLayoutEnd();
+    }
+    GuiLayoutEnd();
+
+    RGLSetHitIndex(NULL);
+    RGLHitIndexBuild(&g_hit);
+}
+
+static int bench_hit_test(void)
+{
+    static unsigned int seed = 1;
+
+    for (int i = 0; i < 256; i++)
+    {
+        seed = seed*1664525u + 1013904223u;
+        float x = (float)(seed >> 8)*(SCREEN.width/16777216.0f);
+        seed = seed*1664525u + 1013904223u;
+        float y = (float)(seed >> 8)*(SCREEN.height/16777216.0f);
+        g_checksum += (double)RGLHitTestTag(&g_hit, x, y);
+    }
+
+    return 256;
+}
+
+// Damage tracking: a 1000-row list where one row per frame changes height, diffed against the previous frame
+#define DAMAGE_ROWS 1000
+static RGLDamageEntry *g_damage_entries = NULL;
+static RGLDamage g_damage = { 0 };
+
+static int bench_damage(void)
+{
+    static int frame = 0;
+    frame++;
+
+    RGLSetDamage(&g_damage);
+    RGLBeginFrame();
+    GuiBeginColumnEx(SCREEN, RGL_PAD_0, 0, NULL);
+    for (int i = 0; i < DAMAGE_ROWS; i++)
+    {
+        GuiLayoutSetNextTag((unsigned int)(i + 1)*2654435761u);
+        GuiLayoutRec((i == frame%DAMAGE_ROWS)? 2.0f : 1.0f, -1);
+    }
+    GuiLayoutEnd();
+    RGLSetDamage(NULL);
+
+    int dirty = RGLDamageBuild(&g_damage);
+    for (int i = 0; i < dirty; i++) sink(g_damage.dirty[i]);
+
+    return DAMAGE_ROWS;
+}
+
+typedef struct BenchCase
+{
+    const char *name;
+    int (*run)(void);
+    int scale; // Iterations are divided by this (heavy cases)
+} BenchCase;
+
+static const BenchCase CASES[] = {
+    { "deep_nesting", bench_deep_nesting, 1 },
+    { "deep_nesting_arena", bench_deep_nesting_arena, 1 },
+    { "wide_plan", bench_wide_plan, 1 },
+    { "wide_plan_static", bench_wide_plan_static, 1 },
+    { "wide_plan_batch", bench_wide_plan_batch, 1 },
+    { "wide_plan_commands", bench_wide_plan_commands, 1 },
+    { "wide_plan_arena", bench_wide_plan_arena, 10 },
+    { "adhoc", bench_adhoc, 1 },
+    { "grid", bench_grid, 10 },
+    { "flow", bench_flow, 10 },
+    { "flex_heavy", bench_flex_heavy, 1 },
+    { "flex_heavy_cached", bench_flex_heavy_cached, 1 },
+    { "responsive", bench_responsive, 1 },
+    { "responsive_cached", bench_responsive_cached, 1 },
+    { "scroll_uniform", bench_scroll_uniform, 1 },
+    { "scroll_variable", bench_scroll_variable, 1 },
+    { "tree_solve", bench_tree_solve, 1 },
+    { "tree_large_serial", bench_tree_large_serial, 1000 },
+    { "tree_large_parallel", bench_tree_large_parallel, 1000 },
+    { "tree_resize", bench_tree_resize, 100 },
+    { "tree_resize_incremental", bench_tree_resize_incremental, 100 },
+    { "text_fit", bench_text_fit, 1 },
+    { "text_fit_cached", bench_text_fit_cached, 1 },
+    { "hit_test", bench_hit_test, 10 },
+    { "damage", bench_damage, 10 },
+};
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    long iterations = (argc > 1)? atol(argv[1]) : 200000;
+    if (iterations <= 0) iterations = 1;
+
+    double *prefix = (double *)malloc((SCROLL_ITEMS + 1)*sizeof(double));
+    GuiScrollIndexBuild(&g_scroll_index, prefix, SCROLL_ITEMS, scroll_item_size_cb, NULL);
+
+    RGLArenaInit(&g_arena, g_arena_memory, sizeof(g_arena_memory));
+    RGLSetDefaultGap(4.0f);
+    RGLSetDefaultPadAll(2.0f);
+
+    g_dash_nodes = (RGLNode *)malloc(DASH_NODES*sizeof(RGLNode));
+    record_dashboard();
+    record_editor();
+    RGLCommandBufferInit(&g_command_buffer, g_commands, RGL_PLAN_MAX);
+    RGLThreadPoolInit(&g_pool, 3); // Serial fallback when built without RGLAYOUT_ENABLE_THREADS
+
+    for (int i = 0; i < 95; i++)
+    {
+        g_glyph_value[i] = 32 + i;
+        g_glyph_advance[i] = (float)(4 + i%5);
+    }
+
+    g_hit_entries = (RGLHitEntry *)malloc(HIT_ENTRIES*sizeof(RGLHitEntry));
+    g_hit_children = (int *)malloc(HIT_ENTRIES*sizeof(int));
+    record_hit_layout();
+
+    g_damage_entries = (RGLDamageEntry *)malloc(3*DAMAGE_ROWS*sizeof(RGLDamageEntry));
+    RGLDamageInit(&g_damage, g_damage_entries, DAMAGE_ROWS);
+
+    printf("benchmark,iterations,rects,ns_per_rect,ns_per_iter,checksum\n");
+
+    for (size_t c = 0; c < sizeof(CASES)/sizeof(CASES[0]); c++)
+    {
+        long count = iterations/CASES[c].scale;
+        if (count <= 0) count = 1;
+
+        // Warm up caches and branch predictors
+        for (long i = 0; i < count/10 + 1; i++) CASES[c].run();
+
+        g_checksum = 0.0;
+        long rects = 0;
+
+        double start = bench_now_ns();
+        for (long i = 0; i < count; i++) rects += CASES[c].run();
+        double elapsed = bench_now_ns() - start;
+
+        printf("%s,%ld,%ld,%.3f,%.3f,%.6e\n", CASES[c].name, count, rects,
+            elapsed/(double)rects, elapsed/(double)count, g_checksum);
+    }
+
+    RGLThreadPoolClose(&g_pool);
+    free(g_damage_entries);
+    free(g_hit_children);
+    free(g_hit_entries);
+    free(g_dash_nodes);
+    free(prefix);
+
+    return 0;
+}
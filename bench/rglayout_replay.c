@@ -0,0 +1,109 @@
+// Headless layout replayer
+//
+// Feeds a call log written by RGLRecorder (RGLAYOUT_ENABLE_RECORD) back
+// through the API without a window (RGLAYOUT_STANDALONE). The first pass
+// compares every rect with the logged one, then the log is replayed at
+// full speed. Output is one CSV line, like rglayout-bench:
+//
+//   log,iterations,frames,rects,ns_per_rect,ns_per_frame,mismatches
+//
+// Exits with 1 when the log is invalid or any rect differs, so a change to
+// the layout code can be checked for bit-identical results.
+//
+// Usage: rglayout-replay <log> [iterations]
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L // Required for: clock_gettime()
+#endif
+
+#define RGLAYOUT_IMPLEMENTATION
+#include "rglayout.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+// Avoid windows.h, it conflicts with raylib-style names (Rectangle, CloseWindow...)
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *freq);
+#else
+#include <time.h>
+#endif
+
+static double replay_now_ns(void)
+{
+#if defined(_WIN32)
+    long long count = 0, freq = 1;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (double)count*1e9/(double)freq;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec*1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+// Stack growth for logs nested deeper than RGL_MAX_STACK
+static unsigned char g_arena_memory[1 << 20];
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <log> [iterations]\n", argv[0]);
+        return 2;
+    }
+    long iterations = (argc > 2)? atol(argv[2]) : 100;
+    if (iterations <= 0) iterations = 1;
+
+    FILE *file = fopen(argv[1], "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+        return 2;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char *log = (unsigned char *)malloc((size > 0)? (size_t)size : 1);
+    size_t read = (size > 0)? fread(log, 1, (size_t)size, file) : 0;
+    fclose(file);
+
+    // Long plans, scroll indices and batch outputs of one frame never exceed the frame's log bytes
+    size_t scratch_size = read + 65536;
+    void *scratch_memory = malloc(scratch_size);
+    RGLArena scratch, arena;
+    RGLArenaInit(&scratch, scratch_memory, scratch_size);
+    RGLArenaInit(&arena, g_arena_memory, sizeof(g_arena_memory));
+
+    RGLContext ctx;
+    RGLInitContext(&ctx);
+    RGLSetArenaCtx(&ctx, &arena);
+
+    // Verify pass
+    RGLReplayResult check = RGLReplayCtx(&ctx, log, read, &scratch);
+    if (!check.valid)
+        fprintf(stderr, "%s: invalid log (bad header, truncated, or scratch exhausted)\n", argv[1]);
+    if (check.mismatches > 0)
+        fprintf(stderr, "%s: %d of %d rects differ, first at log offset %zu\n", argv[1], check.mismatches, check.rects, check.first_mismatch);
+
+    // Timed passes
+    for (long i = 0; i < iterations/10 + 1; i++) RGLReplayCtx(&ctx, log, read, &scratch);
+
+    double start = replay_now_ns();
+    for (long i = 0; i < iterations; i++) RGLReplayCtx(&ctx, log, read, &scratch);
+    double elapsed = replay_now_ns() - start;
+
+    double rects = (double)check.rects*(double)iterations;
+    double frames = (double)check.frames*(double)iterations;
+    printf("log,iterations,frames,rects,ns_per_rect,ns_per_frame,mismatches\n");
+    printf("%s,%ld,%d,%d,%.3f,%.3f,%d\n", argv[1], iterations, check.frames, check.rects,
+        (rects > 0)? elapsed/rects : 0.0, (frames > 0)? elapsed/frames : 0.0, check.mismatches);
+
+    RGLUnloadContext(&ctx);
+    free(scratch_memory);
+    free(log);
+
+    return (check.valid && check.mismatches == 0)? 0 : 1;
+}
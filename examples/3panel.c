@@ -68,7 +68,7 @@ int main(void)
              DebugButton(GuiLayoutRec(-1, -1), "Header");
 
             // Content Row with 3 columns: Left(flex 1), Center(flex 3), Right(flex 1)
-            RGLPlan content_plan = GuiPlanCreate((float[]){1, 3, 1}, 3);
+            RGL_PLAN_DEFINE(content_plan, 1, 3, 1); // Built at compile time
             GuiBeginRow(GuiLayoutRec(-1, -1), &content_plan);
                 DebugButton(GuiLayoutRec(-1, -1), "Left\nSidebar");      // Left Sidebar
                 DebugButton(GuiLayoutRec(-1, -1), "Main\nContent");      // Center Content
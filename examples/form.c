@@ -83,7 +83,7 @@ int main(void)
             GuiLayoutEnd();
 
             // Centered Login button
-            RGLPlan login_row_plan = GuiPlanCreate((float[]){-1, 100, -1}, 3); // space, 100px, space
+            RGL_PLAN_DEFINE(login_row_plan, -1, 100, -1); // space, 100px, space
             GuiBeginRow(GuiLayoutRec(50, -1), &login_row_plan);
                 GuiLayoutRec(-1, -1); // take next rect as Space
                 DebugButton(GuiLayoutRec(-1, -1), "Login");
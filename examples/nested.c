@@ -65,13 +65,13 @@ int main(void)
         GuiBeginColumn(screen_rect, &column_plan);
 
             // Headers
-            RGLPlan header_plan = GuiPlanCreate((float[]){1, 4}, 2);
+            RGL_PLAN_DEFINE(header_plan, 1, 4); // Built at compile time
             GuiBeginRow(GuiLayoutRec(-1, -1), &header_plan);
                 DebugButton(GuiLayoutRec(-1, -1), "Logo");
                 DebugButton(GuiLayoutRec(-1, -1), "Header");
             GuiLayoutEnd();
 
-            RGLPlan content_plan = GuiPlanCreate((float[]){1, 3, 1}, 3);
+            RGL_PLAN_DEFINE(content_plan, 1, 3, 1);
             GuiBeginRow(GuiLayoutRec(-1, -1), &content_plan);
 
                 // Left Sidebar
@@ -103,7 +103,7 @@ int main(void)
 
                     // Main Content
                     GuiBeginRow(GuiLayoutRec(-1, -1), NULL);
-                        RGLPlan main_plan = GuiPlanCreate((float[]){-1, 50}, 2);
+                        RGL_PLAN_DEFINE(main_plan, -1, 50);
                         GuiBeginColumn(GuiLayoutRec(-1, -1), &main_plan);
                             DebugButton(GuiLayoutRec(-1, -1), "Content");
                             DebugButton(GuiLayoutRec(-1, -1), "Footer");
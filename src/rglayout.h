@@ -1,8 +1,15 @@
 #ifndef RGLAYOUT_H
 #define RGLAYOUT_H
 
-// #include "raylib.h"
+#if !defined(RGLAYOUT_STANDALONE)
+#include "raylib.h" // Required for: Rectangle
+#endif
 #include <stdbool.h>
+#include <stddef.h> // Required for: size_t
+#if defined(RGLAYOUT_ENABLE_THREADS) && !defined(_WIN32)
+#include <pthread.h> // Required for: RGLThreadPool
+#include <sched.h>   // Required for: sched_yield()
+#endif
 
 // Function specifiers in case library is build/used as a shared library
 // NOTE: Microsoft specifiers to tell compiler that symbols are imported/exported from a .dll
@@ -28,14 +35,32 @@
 
 // ===== CONFIGURATION =====
 
-// Maximum nesting depth for containers
+// Inline container stack depth (deeper nesting grows into the context arena or allocator)
 #define RGL_MAX_STACK 16
 #define RGL_PLAN_MAX 32
+// Inline resolved child spans shared by all open containers (plans and visible scroll items)
+#define RGL_SPAN_MAX (RGL_MAX_STACK*RGL_PLAN_MAX)
+// Alignment of RGLArenaAlloc() blocks
+#define RGL_ARENA_ALIGN 16
+// Layout cache entries (power of two) and probe window per lookup
+#define RGL_CACHE_SIZE 64
+#define RGL_CACHE_PROBE 4
+// Dirty rectangles reported by RGLDamageBuild() (more damage is merged into them)
+#define RGL_DAMAGE_RECTS 8
+// Text cache: measured strings (power of two) and probe window, glyph advance tables (font, size pairs)
+#define RGL_TEXT_CACHE_SIZE 256
+#define RGL_TEXT_CACHE_PROBE 4
+#define RGL_GLYPH_TABLES 4
+#define RGL_GLYPH_TABLE_SIZE 128 // Codepoints with a cached advance (ASCII), others call the measure function
+// Open trace zones per buffer (deeper containers are not traced)
+#define RGL_TRACE_DEPTH 64
 
 // ===== TYPES & ENUMS =====
 
-// Standalone Support: TODO
+// Standalone Support: define the raylib types rglayout needs when raylib.h is not available
+// NOTE: Layout matches raylib, so headless results can be compared with raylib builds
 #if defined(RGLAYOUT_STANDALONE)
+#if !defined(RL_RECTANGLE_TYPE)
 typedef struct Rectangle
 {
     float x;      // Rectangle top-left corner position x
@@ -43,7 +68,8 @@ typedef struct Rectangle
     float width;  // Rectangle width
     float height; // Rectangle height
 } Rectangle;
-
+#define RL_RECTANGLE_TYPE
+#endif
 #endif
 
 // Layout direction - either horizontal (ROW) or vertical (COLUMN)
@@ -71,49 +97,504 @@ typedef struct RGLPad
     float bottom;
 } RGLPad;
 
+// Frame arena: bump allocator over caller memory, released all at once by RGLBeginFrame()
+typedef struct RGLArena
+{
+    unsigned char *base; // Caller-provided memory
+    size_t size;         // Size of base in bytes
+    size_t used;         // Bytes handed out this frame
+} RGLArena;
+
 // Plan struct
+// NOTE: Short plans live in sizes, long plans in a caller buffer or arena block (entries).
+// Totals and hash are kept by the GuiPlan* builders and RGL_PLAN_INIT, so Begin never re-scans the
+// entries. Plans filled by hand (hash 0) are counted at every Begin; after writing the entries of a
+// built plan directly, call GuiPlanRefresh()
 typedef struct RGLPlan
 {
-    float sizes[RGL_PLAN_MAX]; // Can you allocate a fixed-size array
-    int length;      // Length of sizes array
-    float gap;       // Gap between elements
-    RGLPad pad;      // Container padding
-    bool has_gap;    // Whether gap was explicitly set
-    bool has_pad;    // Whether padding was explicitly set
+    float sizes[RGL_PLAN_MAX]; // Inline entries (entries == NULL)
+    float *entries;    // External entries (NULL: use sizes)
+    int capacity;      // Capacity of entries
+    RGLArena *arena;   // Arena that entries grow from (NULL: fixed capacity)
+    int length;        // Number of entries
+    float sum_fixed;   // Sum of pixel entries (>= 20)
+    float sum_weight;  // Sum of flex weights (-1 counts as 1)
+    unsigned int hash; // Entry hash for the layout cache (0: computed at Begin)
+    float gap;         // Gap between elements
+    RGLPad pad;        // Container padding
+    bool has_gap;      // Whether gap was explicitly set
+    bool has_pad;      // Whether padding was explicitly set
 } RGLPlan;
 
+// Container kind marker stored in RGLContainer.columns for flow containers
+#define RGL_FLOW -1
+
+// Resolved main-axis placement of one planned child
+typedef struct RGLSpan
+{
+    float offset; // Position along main axis (x for rows, y for columns)
+    float size;   // Size along main axis
+} RGLSpan;
+
 // Internal container state tracking layout progress
+// NOTE: Kept to 64 bytes (one cache line), the plan itself is never stored, only its resolved spans
 typedef struct RGLContainer
 {
     // Layout bounds
     Rectangle outer; // Original bounds including padding
     Rectangle inner; // Available space after padding
 
-    // Layout configuration
-    RGLAxis axis; // Row or Column direction
-    float gap;    // Space between children
-    RGLPad pad;   // Container padding
-
     // Dynamic state during layout
     float cursor;    // Current position along main axis
     float remaining; // Remaining space in main axis
+    float gap;       // Space between children
     int placed;      // Number of children placed so far
 
-    // Layout plan (optional)
-    RGLPlan plan;          // Plan specification
-    int plan_index;        // Current position in plan
-    float plan_sum_fixed;  // Total fixed pixels in plan
-    float plan_sum_weight; // Total flex weight in plan
-    float plan_gap_total;  // Total gap space required by plan
+    // Layout plan progress (optional), children [0, plan_length) take their resolved spans
+    int columns;     // Grid column tracks (0: row/column container, RGL_FLOW: flow container)
+    int plan_length; // Number of planned children or grid cells (0: ad-hoc mode)
+    int span_base;   // First resolved plan span (grids: column tracks, then row tracks)
+
+    RGLAxis axis;    // Row or Column direction
 } RGLContainer;
 
+// Cold per-container data, stored beside the stack at the same index (RGLState.info)
+// NOTE: Only touched by IDs and recording, so RGLContainer keeps the layout state in one cache line
+typedef struct RGLContainerInfo
+{
+    unsigned int id; // Hierarchical ID (parent ID and sibling index or user key)
+    int nested;      // Containers begun inside so far (sibling index of the next one)
+    int serial;      // Container number in Begin order this frame (command buffer, -1: not recorded)
+    int item_base;   // ID slot of the first item counted by placed (flows: current line, scrolls: first visible)
+    const RGLSpan *spans; // Cached spans a row/column reads in place (span_base < 0)
+} RGLContainerInfo;
+
 // Global layout state - stack of nested containers
+// NOTE: Stack and spans start in the inline buffers and are grown (doubling) from the context
+// arena or allocator hooks, so pushes never allocate once the frame's peak depth was reached
 typedef struct RGLState
 {
-    RGLContainer stack[RGL_MAX_STACK];
-    int top; // Current stack depth
+    RGLContainer *stack;   // Open containers (inline_stack until grown)
+    RGLContainerInfo *info; // Cold data of the open containers (inline_info until grown, stack_capacity entries)
+    int top;               // Current stack depth
+    int stack_capacity;    // Containers that fit in stack (0: storage not set up yet)
+    int overflow_depth;    // Containers skipped because the stack could not grow
+
+    // Planned child spans, resolved once per container at Begin (stack ordered)
+    RGLSpan *spans;        // Resolved spans (inline_spans until grown)
+    int span_top;          // First free span
+    int span_capacity;     // Spans that fit in spans
+    bool stack_heap;       // stack was allocated with the allocator hooks
+    bool info_heap;        // info was allocated with the allocator hooks
+    bool spans_heap;       // spans was allocated with the allocator hooks
+
+    RGLContainer inline_stack[RGL_MAX_STACK];
+    RGLContainerInfo inline_info[RGL_MAX_STACK];
+    RGLSpan inline_spans[RGL_SPAN_MAX];
 } RGLState;
 
+// Visible items of a virtualized scroll container: [first, first + count)
+typedef struct RGLRange
+{
+    int first; // Index of first visible item
+    int count; // Number of visible items
+} RGLRange;
+
+// Item size callback for variable-size scroll containers
+typedef float (*RGLItemSizeFunc)(int index, void *user);
+
+// Prefix-sum index over variable item sizes (built by GuiScrollIndexBuild)
+// NOTE: Sums are kept in double, so offsets stay exact for lists with millions of rows
+typedef struct RGLScrollIndex
+{
+    double *prefix; // prefix[i] = total size of items [0, i), caller buffer of count + 1 values
+    int count;      // Number of indexed items
+} RGLScrollIndex;
+
+// One entry of a responsive plan table (see GuiBeginRowResponsive)
+// NOTE: The layout cache keys a table by address and entry count, so min_width values must not
+// change while a cache holds the table (reset it after rewriting one). Plans are read every Begin
+typedef struct RGLBreakpoint
+{
+    float min_width;     // Entry applies from this container width up to the next entry's
+    const RGLPlan *plan; // Plan used in that band (NULL: no plan)
+} RGLBreakpoint;
+
+// Cached resolution of one planned container (see RGLLayoutCache)
+typedef struct RGLCacheEntry
+{
+    unsigned int id;        // Container ID (0: empty slot)
+    unsigned int plan_hash; // Plan hash (RGLPlan.hash)
+    unsigned int stamp;     // Last use, for replacement
+    int length;             // Number of cached spans
+    RGLAxis axis;           // Row or Column direction
+    float sum_fixed;        // Plan totals used when resolving
+    float sum_weight;
+    float gap;              // Gap used when resolving
+    Rectangle outer;        // Bounds used when resolving
+    Rectangle inner;        // Bounds after padding used when resolving
+    const RGLBreakpoint *breakpoints; // Responsive table the selection below was made from (NULL: none)
+    int breakpoint_count;   // Entries in that table
+    int breakpoint;         // Selected entry
+    float band_min;         // Selection holds for widths in [band_min, band_max)
+    float band_max;
+    RGLSpan spans[RGL_PLAN_MAX];
+} RGLCacheEntry;
+
+// Opt-in frame-to-frame memoization of planned containers
+// NOTE: Containers opened after GuiLayoutSetNextId() read last frame's spans in place when
+// (id, bounds, padding, gap, plan length, totals and hash) are unchanged, so a hit costs the same
+// for any plan length. Do not reset or swap the cache while containers are open. Responsive
+// containers also keep their selected breakpoint until the width leaves its band, so a steady
+// frame neither scans the table nor the plan. Counters are never reset by the library
+typedef struct RGLLayoutCache
+{
+    RGLCacheEntry entries[RGL_CACHE_SIZE];
+    unsigned int stamp;  // Lookup counter
+    unsigned int hits;   // Containers replayed from cache
+    unsigned int misses; // Containers resolved (and stored)
+} RGLLayoutCache;
+
+// Allocator hook with realloc() semantics (size 0: free ptr)
+typedef void *(*RGLReallocFunc)(void *ptr, size_t size, void *user);
+
+// Error flags reported by RGLGetErrors() (accumulated until the next RGLBeginFrame)
+typedef enum
+{
+    RGL_ERROR_NONE = 0,
+    RGL_ERROR_STACK_OVERFLOW = 1, // Container stack could not grow, containers were skipped
+    RGL_ERROR_SPAN_OVERFLOW = 2,  // Span buffer could not grow, containers skipped or scroll ranges truncated
+    RGL_ERROR_UNBALANCED = 4      // GuiLayoutEnd without Begin, or containers left open at RGLBeginFrame
+} RGLError;
+
+// Recorded rectangle of the hit-test index (widget rect or container bounds)
+typedef struct RGLHitEntry
+{
+    Rectangle rect;      // Rectangle as produced by GuiLayoutRec* or passed to Begin
+    unsigned int tag;    // User tag (GuiLayoutSetNextTag, 0: none)
+    int parent;          // Containing container entry (-1: top level)
+    int depth;           // Nesting depth (0: top level)
+    int first_child;     // Containers: first slot of the child list in RGLHitIndex.children
+    int child_count;     // Containers: number of direct children
+    RGLAxis axis;        // Containers: children are placed along this axis
+    bool container;      // Container (true) or widget rect
+    bool row_major;      // Containers: children ordered by lines (grids, flows)
+    bool sorted;         // Containers: child list is ordered, queries binary search it
+} RGLHitEntry;
+
+// Per-frame spatial index over everything the layout produced, queried by point
+// NOTE: Recording is preorder, RGLHitIndexBuild() then groups children per container (O(n)),
+// and RGLHitTest() descends the hierarchy with one binary search per level
+typedef struct RGLHitIndex
+{
+    RGLHitEntry *entries; // Entry buffer (caller-provided)
+    int *children;        // Child lists grouped by parent, roots first (caller-provided, capacity ints)
+    int capacity;         // Size of both buffers
+    int count;            // Recorded entries
+    int roots;            // Top-level entries (children[0, roots))
+    int current;          // Open container entry (-1: top level)
+    int skip_depth;       // Containers opened after the buffer was full
+    bool overflow;        // Buffer ran out of entries this frame
+    bool built;           // Child lists are up to date
+} RGLHitIndex;
+
+// Draw command recorded for every rect produced by GuiLayoutRec* (plain data, 28 bytes, no padding)
+// NOTE: Layout is four floats (x, y, width, height) followed by three 32-bit integers,
+// so the array can be handed to a renderer or copied as is
+typedef struct RGLCommand
+{
+    Rectangle rect;      // Rectangle as returned to the caller
+    unsigned int tag;    // User tag (GuiLayoutSetNextTag, 0: none), e.g. widget type or texture
+    int depth;           // Open containers when the rect was produced (0: top level)
+    int container;       // Enclosing container in Begin order this frame (-1: top level)
+} RGLCommand;
+
+// Per-frame command buffer: flat array of RGLCommand in emission (draw) order
+// NOTE: Storage is caller-provided and reused every frame, recording never allocates.
+// Commands past capacity are dropped and flagged, sorting them (e.g. by tag) is up to the caller
+typedef struct RGLCommandBuffer
+{
+    RGLCommand *commands; // Command buffer (caller-provided)
+    int capacity;         // Commands that fit in the buffer
+    int count;            // Recorded commands
+    int containers;       // Containers begun this frame (next container index)
+    bool overflow;        // Buffer ran out of commands this frame
+} RGLCommandBuffer;
+
+// Keyed rect of one frame, as recorded by the damage tracker
+typedef struct RGLDamageEntry
+{
+    Rectangle rect;   // Rectangle as returned to the caller
+    unsigned int key; // Widget key (tag if set, otherwise the hierarchical ID)
+} RGLDamageEntry;
+
+// Damage tracker: diffs this frame's keyed rects against the previous frame's
+// NOTE: Rects are matched by key, rects that moved, resized, appeared or disappeared are damaged
+// (old and new area), plus areas flagged with RGLDamageAddRect(). Damage is coalesced into at most
+// RGL_DAMAGE_RECTS rectangles, 'full' asks for a full redraw (first frame, overflow, invalidate)
+typedef struct RGLDamage
+{
+    RGLDamageEntry *current;  // Rects recorded this frame
+    RGLDamageEntry *previous; // Rects of the last built frame, sorted by key
+    RGLDamageEntry *scratch;  // Sort buffer
+    int capacity;             // Entries per buffer
+    int count;                // Rects recorded this frame
+    int previous_count;       // Rects of the last built frame
+    Rectangle dirty[RGL_DAMAGE_RECTS]; // Damaged areas (valid after RGLDamageBuild)
+    int dirty_count;          // Damaged areas
+    bool full;                // Everything must be redrawn (dirty is empty)
+    bool overflow;            // Buffer ran out of entries this frame
+    bool valid;               // Previous frame is available for diffing
+} RGLDamage;
+
+// Glyph advance callback: horizontal advance of a codepoint (spacing excluded) for font at size
+// NOTE: font is whatever RGLSetTextFont() was given (raylib: const Font *, NULL: default font)
+typedef float (*RGLGlyphAdvanceFunc)(int codepoint, const void *font, float size, void *user);
+
+// Measured string (RGLTextCache entry)
+typedef struct RGLTextCacheEntry
+{
+    unsigned int hash;  // String hash (0: empty slot)
+    int length;         // String length in bytes
+    const void *font;   // Font passed to the measure function
+    float size;         // Font size
+    float spacing;      // Spacing between glyphs
+    float width;        // Measured width (widest line)
+    float height;       // Measured height (lines*size)
+    unsigned int stamp; // Last lookup that used this entry (LRU replacement)
+} RGLTextCacheEntry;
+
+// Glyph advances of one (font, size) pair, filled on first use
+typedef struct RGLGlyphTable
+{
+    const void *font;   // Font passed to the measure function
+    float size;         // Font size (0: unused table)
+    unsigned int stamp; // Last use (LRU replacement)
+    float advance[RGL_GLYPH_TABLE_SIZE]; // Advance per codepoint (< 0: not measured yet)
+} RGLGlyphTable;
+
+// Opt-in text measurement cache for GuiLayoutRecText / RGLMeasureText
+// NOTE: Strings are keyed by (hash, length, font, size, spacing), a hash collision returns the other
+// string's size. Reset the cache when fonts are unloaded or the measure function changes
+typedef struct RGLTextCache
+{
+    RGLTextCacheEntry entries[RGL_TEXT_CACHE_SIZE];
+    RGLGlyphTable tables[RGL_GLYPH_TABLES];
+    unsigned int stamp;  // Lookup counter
+    unsigned int hits;   // Strings found in the cache
+    unsigned int misses; // Strings measured (and stored)
+} RGLTextCache;
+
+// Per-frame layout counters (RGLAYOUT_ENABLE_STATS, all zero otherwise)
+// NOTE: Cycle counts need RGLAYOUT_STATS_TIMING and a cycle counter (x86 rdtsc or RGL_STATS_CLOCK())
+typedef struct RGLFrameStats
+{
+    int containers;                  // Containers pushed
+    int rects;                       // Rects produced by GuiLayoutRec*, GuiLayoutCell*
+    int planned;                     // Rects taken from a plan, grid cells or visible scroll items
+    int adhoc;                       // Rects placed ad hoc (no plan, flows, past the plan)
+    int plan_exhausted;              // Rects requested past the plan of a planned container or grid
+    int overflows;                   // Containers skipped (stack or span storage could not grow)
+    int zero_rects;                  // Rects with zero width or height (clamped, no space left, no container)
+    int max_depth;                   // Deepest nesting reached
+    unsigned long long begin_cycles; // Cycles spent in GuiBegin* (pushed containers)
+    unsigned long long rec_cycles;   // Cycles spent in GuiLayoutRec* (rects from a container)
+    unsigned long long end_cycles;   // Cycles spent in GuiLayoutEnd
+} RGLFrameStats;
+
+// Trace zone: one container from GuiBegin* to GuiLayoutEnd (RGLAYOUT_ENABLE_TRACE)
+typedef struct RGLTraceEvent
+{
+    unsigned long long start;    // Begin timestamp (ns, RGL_TRACE_CLOCK())
+    unsigned long long duration; // Time until GuiLayoutEnd (ns)
+    const char *name;            // GuiLayoutSetNextZone() name or container kind (static storage)
+    unsigned int id;             // Hierarchical ID of the container
+    int depth;                   // Nesting level (1: top-level container)
+} RGLTraceEvent;
+
+// Trace ring buffer: zones of one context, written by the thread laying it out
+// NOTE: Single producer, the head is published with a release store so RGLTraceExport() can run on
+// another thread. Zones are written when they end, the oldest are overwritten when the ring is full
+typedef struct RGLTraceBuffer
+{
+    RGLTraceEvent *events;  // Ring storage (caller memory)
+    unsigned int capacity;  // Ring size (power of two)
+    unsigned int head;      // Zones written so far
+    unsigned int tail;      // Zones exported so far
+    unsigned int dropped;   // Zones overwritten before they were exported
+    int thread_id;          // Thread id of the zones in the exported trace
+    int open;               // Containers begun and not ended yet
+    RGLTraceEvent zones[RGL_TRACE_DEPTH]; // Open zones (start, name, id, depth)
+} RGLTraceBuffer;
+
+// Call log of Begin/Rec/End with arguments and resulting rects (RGLAYOUT_ENABLE_RECORD)
+// NOTE: Values are stored in native byte order, replay logs on a machine of the same endianness.
+// When the buffer fills up the log is cut back to the last RGLBeginFrame, so it holds whole frames
+typedef struct RGLRecorder
+{
+    unsigned char *data; // Log storage (caller memory)
+    size_t capacity;     // Bytes available
+    size_t size;         // Bytes written (header included)
+    size_t frame_start;  // Log offset of the current frame
+    int frames;          // Complete and current frames in the log
+    bool overflow;       // Buffer ran out, recording stopped until RGLRecorderReset
+} RGLRecorder;
+
+// Outcome of RGLReplay
+typedef struct RGLReplayResult
+{
+    int frames;            // RGLBeginFrame calls replayed
+    int calls;             // Begin/Rec/End calls replayed
+    int rects;             // Rects compared with the log
+    int mismatches;        // Rects that differ from the recorded ones (bitwise)
+    size_t first_mismatch; // Log offset of the first call with a differing rect
+    bool valid;            // Whole log replayed (false: bad header, truncated log or scratch exhausted)
+} RGLReplayResult;
+
+// Layout context - everything a layout tree needs (stack, defaults, last rect)
+// NOTE: Contexts share no mutable state, independent trees can be laid out on separate threads
+typedef struct RGLContext
+{
+    RGLState state;           // Container stack
+    Rectangle last_rect;      // Last rectangle produced by GuiLayoutRec*
+    RGLPad default_pad;       // Padding used by GuiBeginRow/GuiBeginColumn
+    float default_gap;        // Gap used by GuiBeginRow/GuiBeginColumn
+    RGLVAlign default_valign; // Alignment used by GuiLayoutRec
+    RGLLayoutCache *cache;    // Optional layout cache (NULL: disabled)
+    unsigned int next_id;     // ID for the next container (0: none)
+    RGLArena *arena;          // Optional frame arena for stack growth (NULL: none)
+    RGLReallocFunc alloc_fn;  // Optional allocator for stack growth, takes precedence over arena
+    void *alloc_user;         // User pointer passed to alloc_fn
+    int errors;               // RGLError flags raised since the last RGLBeginFrame
+    RGLHitIndex *hit;         // Optional hit-test index recording (NULL: disabled)
+    unsigned int next_tag;    // Tag for the next recorded rect or container (0: none)
+    RGLCommandBuffer *commands; // Optional command buffer recording (NULL: disabled)
+    RGLDamage *damage;        // Optional damage tracking (NULL: disabled)
+
+    // Hierarchical IDs (GuiLayoutIdLast hashes the last rect's parent ID and slot on demand)
+    unsigned int next_key;    // User key for the next rect or container (0: sibling index)
+    int root_nested;          // Top-level containers begun this frame
+    unsigned int last_parent; // ID of the container that produced the last rect (0: none)
+    unsigned int last_slot;   // Sibling index or user key of the last rect
+    bool last_keyed;          // last_slot is a user key
+    int last_nested;          // Containers opened on the last rect so far
+
+    // Text measurement (GuiLayoutRecText)
+    RGLGlyphAdvanceFunc measure_fn; // Glyph advance callback (NULL: built-in metric)
+    void *measure_user;       // User pointer passed to measure_fn
+    const void *text_font;    // Font passed to measure_fn
+    float text_size;          // Font size
+    float text_spacing;       // Spacing between glyphs
+    RGLTextCache *text_cache; // Optional text cache (NULL: measure every call)
+
+    RGLFrameStats stats;      // Counters of the frame in progress (RGLAYOUT_ENABLE_STATS)
+    RGLFrameStats last_stats; // Counters of the last completed frame
+    RGLTraceBuffer *trace;    // Optional zone tracing (RGLAYOUT_ENABLE_TRACE, NULL: disabled)
+    const char *next_zone;    // Trace zone name for the next container (NULL: container kind)
+    RGLRecorder *recorder;    // Optional call log (RGLAYOUT_ENABLE_RECORD, NULL: disabled)
+} RGLContext;
+
+// ===== DEFERRED LAYOUT TREE =====
+
+// Size value for tree nodes: size to content (measured bottom-up)
+// NOTE: Only meaningful for RGLTree* functions, immediate mode treats it as fill
+#define RGL_FIT -2.0f
+
+// Handle of a recorded tree node (index into the node arena)
+typedef int RGLNodeId;
+#define RGL_NODE_NONE -1
+
+// Retained layout node (recorded by RGLTree* calls, solved by RGLTreeSolve)
+typedef struct RGLNode
+{
+    // Recorded input
+    float req_w;         // Requested width: >= 0 px, RGL_FIT content, other < 0 fill
+    float req_h;         // Requested height: >= 0 px, RGL_FIT content, other < 0 fill
+    RGLPad pad;          // Container padding
+    float gap;           // Space between children
+    int parent;          // Parent node (RGL_NODE_NONE: root)
+    int subtree;         // Nodes in subtree including this one, [id, id + subtree) in preorder
+    int children;        // Number of direct children
+    RGLAxis axis;        // Container direction
+    bool container;      // Container (true) or leaf
+
+    // Measure pass (bottom-up)
+    float content_w;     // Leaf: intrinsic width, container: measured width incl. padding
+    float content_h;     // Leaf: intrinsic height, container: measured height incl. padding
+    float acc_main;      // Sum of children preferred main sizes
+    float acc_cross;     // Max of children preferred cross sizes
+    float fixed_main;    // Sum of non-fill children main sizes
+    int fill_count;      // Number of fill children along main axis
+
+    // Arrange pass (top-down)
+    Rectangle rect;      // Solved rectangle
+    Rectangle inner;     // Solved rectangle after padding
+    float cursor;        // Next child position along main axis
+    float remaining;     // Remaining main axis space
+    float fill_size;     // Main size of each fill child
+    int placed;          // Children placed so far
+} RGLNode;
+
+// Deferred layout tree: nodes recorded into a caller-provided arena, solved in O(n)
+typedef struct RGLTree
+{
+    RGLNode *nodes;      // Node arena (caller-provided)
+    int count;           // Recorded nodes
+    int capacity;        // Arena size
+    int current;         // Open container (RGL_NODE_NONE: top level)
+    int skip_depth;      // Containers opened after the arena was full
+    bool overflow;       // Arena ran out of nodes this frame
+    RGLPad default_pad;  // Padding used by RGLTreeBeginRow/RGLTreeBeginColumn
+    float default_gap;   // Gap used by RGLTreeBeginRow/RGLTreeBeginColumn
+    bool solved;         // Measured by a full solve since the last recorded node (incremental solves allowed)
+} RGLTree;
+
+// Parallel tree solve (optional, #define RGLAYOUT_ENABLE_THREADS, POSIX threads)
+// NOTE: Without thread support RGLTreeSolveParallel() runs the serial solver
+#define RGL_POOL_MAX_THREADS 16      // Maximum worker threads in a pool
+#define RGL_POOL_DEQUE_SIZE 256      // Pending subtree tasks per worker (extra tasks run inline)
+#define RGL_PARALLEL_MIN_NODES 4096  // Default: trees smaller than this are solved serially
+#define RGL_PARALLEL_TASK_NODES 512  // Default: smallest subtree handed out as a task
+
+// Work-stealing deque of subtree tasks (owner pops newest, thieves steal oldest)
+typedef struct RGLWorkDeque
+{
+    int tasks[RGL_POOL_DEQUE_SIZE]; // Node ids of containers whose children are not arranged yet
+    int head;                       // Oldest task (steal end)
+    int tail;                       // One past newest task (owner end)
+    int lock;                       // Spinlock
+} RGLWorkDeque;
+
+// Worker thread start argument
+typedef struct RGLPoolWorker
+{
+    struct RGLThreadPool *pool;
+    int index; // Deque index (1..thread_count)
+} RGLPoolWorker;
+
+// Small built-in thread pool for RGLTreeSolveParallel (the calling thread participates)
+// NOTE: Workers keep a pointer to the pool, it must not move between Init and Close
+typedef struct RGLThreadPool
+{
+    int thread_count;                            // Worker threads started (0: serial fallback)
+    int min_nodes;                               // Trees below this node count are solved serially
+    int task_nodes;                              // Subtrees below this node count are not split off
+    RGLWorkDeque deques[RGL_POOL_MAX_THREADS + 1]; // One per worker, [0] is the calling thread
+
+    // Current job (shared)
+    RGLNode *nodes;
+    int pending;                                 // Tasks queued or running
+    int generation;                              // Incremented per job, wakes workers
+    bool shutdown;
+#if defined(RGLAYOUT_ENABLE_THREADS) && !defined(_WIN32)
+    RGLPoolWorker workers[RGL_POOL_MAX_THREADS];
+    pthread_t threads[RGL_POOL_MAX_THREADS];
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+    bool started;                                // mutex and wake are initialized (successful Init until Close)
+#endif
+} RGLThreadPool;
+
 // ===== PADDING HELPERS =====
 
 #define RGL_PAD_0 (RGLPad){0, 0, 0, 0}
@@ -121,18 +602,99 @@ typedef struct RGLState
 
 // ===== FUNCTION DECLARATIONS =====
 
+// Context functions
+// NOTE: Functions without the Ctx suffix use the current context of the calling thread,
+// which is a shared default context unless RGLSetContext() was called on that thread
+RGLAYOUTAPI void RGLInitContext(RGLContext *ctx);   // Reset context to library defaults (empty stack)
+RGLAYOUTAPI void RGLSetContext(RGLContext *ctx);    // Set current context for calling thread (NULL: default context)
+RGLAYOUTAPI RGLContext *RGLGetContext(void);        // Get current context for calling thread
+RGLAYOUTAPI void RGLUnloadContext(RGLContext *ctx); // Free buffers grown with the allocator hooks
+
+// Frame and memory functions
+// NOTE: Without an arena or allocator, nesting deeper than RGL_MAX_STACK is skipped and reported
+RGLAYOUTAPI void RGLArenaInit(RGLArena *arena, void *memory, size_t size);  // Use caller memory as a frame arena
+RGLAYOUTAPI void RGLArenaReset(RGLArena *arena);                            // Release every block at once
+RGLAYOUTAPI void *RGLArenaAlloc(RGLArena *arena, size_t size);              // RGL_ARENA_ALIGN aligned block (NULL: exhausted)
+RGLAYOUTAPI void RGLSetArena(RGLArena *arena);                              // Grow stack and spans from arena (NULL: disable)
+RGLAYOUTAPI void RGLSetArenaCtx(RGLContext *ctx, RGLArena *arena);
+RGLAYOUTAPI void RGLSetAllocator(RGLReallocFunc alloc_fn, void *user);      // Grow stack and spans with alloc_fn (kept across frames)
+RGLAYOUTAPI void RGLSetAllocatorCtx(RGLContext *ctx, RGLReallocFunc alloc_fn, void *user);
+RGLAYOUTAPI void RGLBeginFrame(void);                                       // Reset stack, errors and arena
+RGLAYOUTAPI void RGLBeginFrameCtx(RGLContext *ctx);
+RGLAYOUTAPI int RGLGetErrors(void);                                         // RGLError flags since RGLBeginFrame
+RGLAYOUTAPI int RGLGetErrorsCtx(RGLContext *ctx);
+RGLAYOUTAPI RGLFrameStats RGLGetFrameStats(void);                           // Counters of the last completed frame (RGLAYOUT_ENABLE_STATS)
+RGLAYOUTAPI RGLFrameStats RGLGetFrameStatsCtx(RGLContext *ctx);
+
+// Layout cache functions
+RGLAYOUTAPI void RGLSetLayoutCache(RGLLayoutCache *cache);                  // Enable memoization (NULL: disable)
+RGLAYOUTAPI void RGLSetLayoutCacheCtx(RGLContext *ctx, RGLLayoutCache *cache);
+RGLAYOUTAPI void RGLLayoutCacheReset(RGLLayoutCache *cache);                // Clear entries and counters
+RGLAYOUTAPI void GuiLayoutSetNextId(unsigned int id);                       // Cache key for the next Begin (0: none)
+RGLAYOUTAPI void GuiLayoutSetNextIdCtx(RGLContext *ctx, unsigned int id);
+RGLAYOUTAPI unsigned int RGLHashString(const char *text);                   // Stable non-zero ID from a string
+
+// Call-site ID: unique per source line, e.g. GuiLayoutSetNextId(RGL_ID_HERE)
+#define RGL__STR2(x) #x
+#define RGL__STR(x) RGL__STR2(x)
+#define RGL_ID_HERE RGLHashString(__FILE__ ":" RGL__STR(__LINE__))
+
 // Configuration functions
 RGLAYOUTAPI void RGLSetDefaultPadAll(float p);
 RGLAYOUTAPI void RGLSetDefaultPad(RGLPad p);
 RGLAYOUTAPI void RGLSetDefaultVAlign(RGLVAlign align);
 RGLAYOUTAPI void RGLSetDefaultGap(float g);
+RGLAYOUTAPI void RGLSetDefaultPadAllCtx(RGLContext *ctx, float p);
+RGLAYOUTAPI void RGLSetDefaultPadCtx(RGLContext *ctx, RGLPad p);
+RGLAYOUTAPI void RGLSetDefaultVAlignCtx(RGLContext *ctx, RGLVAlign align);
+RGLAYOUTAPI void RGLSetDefaultGapCtx(RGLContext *ctx, float g);
 
 // Plan Builder Functions
-RGLAYOUTAPI RGLPlan GuiPlanCreate(const float *sizes, int length);
+RGLAYOUTAPI RGLPlan GuiPlanCreate(const float *sizes, int length);               // Up to RGL_PLAN_MAX entries
+RGLAYOUTAPI RGLPlan GuiPlanCreateBuffer(float *buffer, int capacity);             // Empty plan storing entries in a caller buffer
+RGLAYOUTAPI RGLPlan GuiPlanCreateArena(RGLArena *arena, int capacity);            // Empty plan growing in a frame arena (valid until reset)
 RGLAYOUTAPI void GuiPlanAdd(RGLPlan *plan, float size);
+RGLAYOUTAPI void GuiPlanAddRepeat(RGLPlan *plan, float size, int count);
 RGLAYOUTAPI void GuiPlanSetGap(RGLPlan *plan, float gap);
 RGLAYOUTAPI void GuiPlanSetPad(RGLPlan *plan, RGLPad pad);
 RGLAYOUTAPI void GuiPlanSetPadAll(RGLPlan *plan, float pad);
+RGLAYOUTAPI void GuiPlanRefresh(RGLPlan *plan);                                   // Recompute totals and hash after editing entries directly
+
+// Compile-time plans: entries, length and totals are constant expressions (up to RGL_PLAN_MAX entries)
+// NOTE: RGL_PLAN_DEFINE() places the plan in read-only data, so Begin only reads it, nothing is built per frame.
+// RGL_PLAN() is a compound literal for one-off use, the compiler may still copy it per call
+#define RGL_PLAN_INIT(...) { .sizes = { __VA_ARGS__ }, .length = RGL__NARGS(__VA_ARGS__), \
+    .sum_fixed = RGL__SUM(RGL__FIXED, __VA_ARGS__), .sum_weight = RGL__SUM(RGL__WEIGHT, __VA_ARGS__), \
+    .hash = RGL__HASH(__VA_ARGS__) }
+#define RGL_PLAN_DEFINE(name, ...) static const RGLPlan name = RGL_PLAN_INIT(__VA_ARGS__)
+#define RGL_PLAN(...) (&(const RGLPlan)RGL_PLAN_INIT(__VA_ARGS__))
+
+// Entry classification, same rules (and summation order) as GuiPlanAdd; padding value -2 adds 0
+#define RGL__FIXED(v) (((float)(v) >= 20) ? (float)(v) : 0.0f)
+#define RGL__WEIGHT(v) (((float)(v) == -1) ? 1.0f : ((float)(v) > 0 && (float)(v) < 20) ? (float)(v) : 0.0f)
+#define RGL__NARGS(...) RGL__NARGS_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define RGL__NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+#define RGL__SUM(F, ...) RGL__SUM_(F, __VA_ARGS__, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2)
+#define RGL__SUM_(F, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, ...) \
+    (0.0f + F(_1) + F(_2) + F(_3) + F(_4) + F(_5) + F(_6) + F(_7) + F(_8) + F(_9) + F(_10) + F(_11) + F(_12) + F(_13) + F(_14) + F(_15) + F(_16) + F(_17) + F(_18) + F(_19) + F(_20) + F(_21) + F(_22) + F(_23) + F(_24) + F(_25) + F(_26) + F(_27) + F(_28) + F(_29) + F(_30) + F(_31) + F(_32))
+
+// Plan hash, same expression as GuiPlanAdd: seed plus one term per entry, summed.
+// Entries are hashed in 1/65536 steps (constant expressions cannot read float bits), keyed by their
+// index and run through a multiply-xorshift mixer, so reordered entries hash apart. Padding -2 adds 0
+#define RGL__PLAN_SEED 2166136261u
+#define RGL__QUANT(v) ((((float)(v) > -1.0e12f) && ((float)(v) < 1.0e12f)) ? (unsigned long long)(long long)((float)(v)*65536.0f) : 0x9e3779b97f4a7c15ull)
+#define RGL__MIX(x) ((((x) ^ ((x) >> 29))*0xbf58476d1ce4e5b9ull) >> 32)
+#define RGL__ENTRY_HASH(v, i) (((float)(v) == -2) ? 0u : \
+    (unsigned int)RGL__MIX((RGL__QUANT(v) ^ ((unsigned long long)(i) + 1u)*0x632be59bd9b4e019ull)*0x9e3779b97f4a7c15ull))
+#define RGL__HASH(...) RGL__HASH_(__VA_ARGS__, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2)
+#define RGL__HASH_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, ...) \
+    (RGL__PLAN_SEED + RGL__ENTRY_HASH(_1, 0) + RGL__ENTRY_HASH(_2, 1) + RGL__ENTRY_HASH(_3, 2) + RGL__ENTRY_HASH(_4, 3) + \
+    RGL__ENTRY_HASH(_5, 4) + RGL__ENTRY_HASH(_6, 5) + RGL__ENTRY_HASH(_7, 6) + RGL__ENTRY_HASH(_8, 7) + RGL__ENTRY_HASH(_9, 8) + \
+    RGL__ENTRY_HASH(_10, 9) + RGL__ENTRY_HASH(_11, 10) + RGL__ENTRY_HASH(_12, 11) + RGL__ENTRY_HASH(_13, 12) + RGL__ENTRY_HASH(_14, 13) + \
+    RGL__ENTRY_HASH(_15, 14) + RGL__ENTRY_HASH(_16, 15) + RGL__ENTRY_HASH(_17, 16) + RGL__ENTRY_HASH(_18, 17) + RGL__ENTRY_HASH(_19, 18) + \
+    RGL__ENTRY_HASH(_20, 19) + RGL__ENTRY_HASH(_21, 20) + RGL__ENTRY_HASH(_22, 21) + RGL__ENTRY_HASH(_23, 22) + RGL__ENTRY_HASH(_24, 23) + \
+    RGL__ENTRY_HASH(_25, 24) + RGL__ENTRY_HASH(_26, 25) + RGL__ENTRY_HASH(_27, 26) + RGL__ENTRY_HASH(_28, 27) + RGL__ENTRY_HASH(_29, 28) + \
+    RGL__ENTRY_HASH(_30, 29) + RGL__ENTRY_HASH(_31, 30) + RGL__ENTRY_HASH(_32, 31))
 
 // Padding helper functions
 RGLAYOUTAPI RGLPad RGLPadAll(float p);
@@ -142,23 +704,185 @@ RGLAYOUTAPI RGLPad RGLPadL(float x);
 RGLAYOUTAPI RGLPad RGLPadR(float x);
 
 // Core layout functions
-RGLAYOUTAPI void GuiBeginRow(Rectangle bounds, RGLPlan *plan);                                         // Uses defaults, plan optional
-RGLAYOUTAPI void GuiBeginRowEx(Rectangle bounds, RGLPad pad, float gap, RGLPlan *plan);               // Expert version, plan optional
-RGLAYOUTAPI void GuiBeginColumn(Rectangle bounds, RGLPlan *plan);                                      // Uses defaults, plan optional
-RGLAYOUTAPI void GuiBeginColumnEx(Rectangle bounds, RGLPad pad, float gap, RGLPlan *plan);            // Expert version, plan optional
+RGLAYOUTAPI void GuiBeginRow(Rectangle bounds, const RGLPlan *plan);                                         // Uses defaults, plan optional
+RGLAYOUTAPI void GuiBeginRowEx(Rectangle bounds, RGLPad pad, float gap, const RGLPlan *plan);               // Expert version, plan optional
+RGLAYOUTAPI void GuiBeginColumn(Rectangle bounds, const RGLPlan *plan);                                      // Uses defaults, plan optional
+RGLAYOUTAPI void GuiBeginColumnEx(Rectangle bounds, RGLPad pad, float gap, const RGLPlan *plan);            // Expert version, plan optional
+RGLAYOUTAPI void GuiBeginRowCtx(RGLContext *ctx, Rectangle bounds, const RGLPlan *plan);
+RGLAYOUTAPI void GuiBeginRowExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, const RGLPlan *plan);
+RGLAYOUTAPI void GuiBeginColumnCtx(RGLContext *ctx, Rectangle bounds, const RGLPlan *plan);
+RGLAYOUTAPI void GuiBeginColumnExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, const RGLPlan *plan);
+RGLAYOUTAPI void GuiBeginRowResponsive(Rectangle bounds, const RGLBreakpoint *breakpoints, int count);      // Plan picked by bounds width, uses defaults
+RGLAYOUTAPI void GuiBeginColumnResponsive(Rectangle bounds, const RGLBreakpoint *breakpoints, int count);   // Plan picked by bounds width, uses defaults
+RGLAYOUTAPI void GuiBeginRowResponsiveCtx(RGLContext *ctx, Rectangle bounds, const RGLBreakpoint *breakpoints, int count);
+RGLAYOUTAPI void GuiBeginColumnResponsiveCtx(RGLContext *ctx, Rectangle bounds, const RGLBreakpoint *breakpoints, int count);
+
+// Virtualized scroll containers: only the visible items get rects
+// NOTE: Call GuiLayoutRec once per visible item (range.count times), main size comes from the container
+RGLAYOUTAPI RGLRange GuiBeginScrollRow(Rectangle bounds, float scroll, int count, float item_size);                       // Uniform items, uses defaults
+RGLAYOUTAPI RGLRange GuiBeginScrollRowEx(Rectangle bounds, RGLPad pad, float gap, float scroll, int count, float item_size, const RGLScrollIndex *index); // index: variable items (optional)
+RGLAYOUTAPI RGLRange GuiBeginScrollColumn(Rectangle bounds, float scroll, int count, float item_size);                    // Uniform items, uses defaults
+RGLAYOUTAPI RGLRange GuiBeginScrollColumnEx(Rectangle bounds, RGLPad pad, float gap, float scroll, int count, float item_size, const RGLScrollIndex *index); // index: variable items (optional)
+RGLAYOUTAPI RGLRange GuiBeginScrollRowCtx(RGLContext *ctx, Rectangle bounds, float scroll, int count, float item_size);
+RGLAYOUTAPI RGLRange GuiBeginScrollRowExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, float scroll, int count, float item_size, const RGLScrollIndex *index);
+RGLAYOUTAPI RGLRange GuiBeginScrollColumnCtx(RGLContext *ctx, Rectangle bounds, float scroll, int count, float item_size);
+RGLAYOUTAPI RGLRange GuiBeginScrollColumnExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, float scroll, int count, float item_size, const RGLScrollIndex *index);
+
+// Scroll helpers
+RGLAYOUTAPI void GuiScrollIndexBuild(RGLScrollIndex *index, double *buffer, int count, RGLItemSizeFunc size_fn, void *user); // buffer: count + 1 values
+RGLAYOUTAPI void GuiScrollIndexUpdate(RGLScrollIndex *index, int from, RGLItemSizeFunc size_fn, void *user);                 // Re-sum sizes of items [from, count)
+RGLAYOUTAPI float GuiScrollContentSize(int count, float item_size, float gap, const RGLScrollIndex *index);                 // Total scrollable extent
+
+// Grid containers: column and row tracks follow the plan rules, any cell is fetched in O(1)
+// NOTE: GuiLayoutRec returns the next cell in row-major order, GuiLayoutCell* picks cells directly
+RGLAYOUTAPI void GuiBeginGrid(Rectangle bounds, const RGLPlan *col_plan, const RGLPlan *row_plan);                       // Uses defaults
+RGLAYOUTAPI void GuiBeginGridEx(Rectangle bounds, RGLPad pad, float gap, const RGLPlan *col_plan, const RGLPlan *row_plan);
+RGLAYOUTAPI void GuiBeginGridCtx(RGLContext *ctx, Rectangle bounds, const RGLPlan *col_plan, const RGLPlan *row_plan);
+RGLAYOUTAPI void GuiBeginGridExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, const RGLPlan *col_plan, const RGLPlan *row_plan);
+RGLAYOUTAPI Rectangle GuiLayoutCell(int row, int col);                                           // Zero rect outside the grid
+RGLAYOUTAPI Rectangle GuiLayoutCellSpan(int row, int col, int row_span, int col_span);          // Spans are clamped to the grid
+RGLAYOUTAPI Rectangle GuiLayoutCellCtx(RGLContext *ctx, int row, int col);
+RGLAYOUTAPI Rectangle GuiLayoutCellSpanCtx(RGLContext *ctx, int row, int col, int row_span, int col_span);
+
+// Flow containers: GuiLayoutRec(width, height) places items left to right, wrapping onto new lines
+// NOTE: width -1 fills the rest of the line, height -1 uses line_size. Items may extend past the bottom
+RGLAYOUTAPI void GuiBeginFlow(Rectangle bounds, float line_size);                                // Uses defaults
+RGLAYOUTAPI void GuiBeginFlowEx(Rectangle bounds, RGLPad pad, float gap, float line_size);      // gap: between items and lines
+RGLAYOUTAPI void GuiBeginFlowCtx(RGLContext *ctx, Rectangle bounds, float line_size);
+RGLAYOUTAPI void GuiBeginFlowExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, float line_size);
+
+// Content extent of the current container so far, including padding (x, y unused)
+// NOTE: Flows report their wrapped width and height, rows/columns the space used along the main axis
+RGLAYOUTAPI Rectangle GuiLayoutContentSize(void);
+RGLAYOUTAPI Rectangle GuiLayoutContentSizeCtx(RGLContext *ctx);
 
 // Layout state functions
 RGLAYOUTAPI void GuiLayoutEnd(void);
+RGLAYOUTAPI void GuiLayoutEndCtx(RGLContext *ctx);
 
 RGLAYOUTAPI Rectangle GuiLayoutRec(float main, float cross);                                                             // Uses defaults
 RGLAYOUTAPI Rectangle GuiLayoutRecAlign(float main, float cross, RGLVAlign valign);                                                             // Uses defaults
 RGLAYOUTAPI Rectangle GuiLayoutRecEx(float main, float cross, float pl, float pr, float pt, float pb, RGLVAlign valign); // Expert version
+RGLAYOUTAPI Rectangle GuiLayoutRecCtx(RGLContext *ctx, float main, float cross);
+RGLAYOUTAPI Rectangle GuiLayoutRecAlignCtx(RGLContext *ctx, float main, float cross, RGLVAlign valign);
+RGLAYOUTAPI Rectangle GuiLayoutRecExCtx(RGLContext *ctx, float main, float cross, float pl, float pr, float pt, float pb, RGLVAlign valign);
+
+// Batch version of GuiLayoutRec: 'count' rects with the same (main, cross) written as struct-of-arrays
+// NOTE: Results match 'count' GuiLayoutRec calls (default valign), returns rects written
+RGLAYOUTAPI int GuiLayoutRecN(int count, float main, float cross, float *out_x, float *out_y, float *out_w, float *out_h);
+RGLAYOUTAPI int GuiLayoutRecNCtx(RGLContext *ctx, int count, float main, float cross, float *out_x, float *out_y, float *out_w, float *out_h);
+
+// Get all planned rectangles of the current container at once (does not advance the layout)
+// NOTE: Rectangles fill the cross axis, returns plan length (may exceed capacity)
+RGLAYOUTAPI int GuiLayoutPlanRecs(Rectangle *out, int capacity);
+RGLAYOUTAPI int GuiLayoutPlanRecsCtx(RGLContext *ctx, Rectangle *out, int capacity);
 
 // New: return the last rectangle produced by GuiLayoutRec / GuiLayoutRecEx
 RGLAYOUTAPI Rectangle GuiLayoutRecLast(void);
+RGLAYOUTAPI Rectangle GuiLayoutRecLastCtx(RGLContext *ctx);
+
+// Text measurement: size rects to fit their text (main axis: width in rows, height in columns)
+// NOTE: The built-in metric uses raylib fonts (GetFontDefault() for a NULL font), standalone builds
+// use a fixed advance of size/2 per glyph so layouts can be measured headless. Lines split at '\n'
+RGLAYOUTAPI void RGLSetTextMeasure(RGLGlyphAdvanceFunc measure_fn, void *user);           // Glyph advance callback (NULL: built-in)
+RGLAYOUTAPI void RGLSetTextMeasureCtx(RGLContext *ctx, RGLGlyphAdvanceFunc measure_fn, void *user);
+RGLAYOUTAPI void RGLSetTextFont(const void *font, float size, float spacing);             // Font for measurement (e.g. match raygui style)
+RGLAYOUTAPI void RGLSetTextFontCtx(RGLContext *ctx, const void *font, float size, float spacing);
+RGLAYOUTAPI void RGLSetTextCache(RGLTextCache *cache);                                     // Enable text caching (NULL: disable)
+RGLAYOUTAPI void RGLSetTextCacheCtx(RGLContext *ctx, RGLTextCache *cache);
+RGLAYOUTAPI void RGLTextCacheReset(RGLTextCache *cache);                                   // Clear entries, glyph tables and counters
+RGLAYOUTAPI Rectangle RGLMeasureText(const char *text);                                    // Text size (x, y unused)
+RGLAYOUTAPI Rectangle RGLMeasureTextCtx(RGLContext *ctx, const char *text);
+RGLAYOUTAPI Rectangle GuiLayoutRecText(const char *text, float pad, float cross);          // main = text size + 2*pad
+RGLAYOUTAPI Rectangle GuiLayoutRecTextCtx(RGLContext *ctx, const char *text, float pad, float cross);
+
+// Hierarchical IDs: every container and rect is identified by its parent's ID and its sibling index
+// NOTE: IDs are stable across frames while the layout structure is (requires RGLBeginFrame), give
+// items of dynamic lists a key so insertions and removals don't shift the IDs of their siblings
+RGLAYOUTAPI unsigned int GuiLayoutIdLast(void);                               // ID of the last rect produced by GuiLayoutRec* (0: none)
+RGLAYOUTAPI unsigned int GuiLayoutIdLastCtx(RGLContext *ctx);
+RGLAYOUTAPI unsigned int GuiLayoutIdCurrent(void);                            // ID of the current container (0: none)
+RGLAYOUTAPI unsigned int GuiLayoutIdCurrentCtx(RGLContext *ctx);
+RGLAYOUTAPI void GuiLayoutSetNextKey(unsigned int key);                       // Use key instead of the sibling index for the next rect or container
+RGLAYOUTAPI void GuiLayoutSetNextKeyCtx(RGLContext *ctx, unsigned int key);
+
+// Hit-test index: record every rect of the frame, then find the widget under a point in O(depth*log n)
+// NOTE: RGLBeginFrame() resets the context's index, call RGLHitIndexBuild() after the layout pass
+RGLAYOUTAPI void RGLHitIndexInit(RGLHitIndex *index, RGLHitEntry *entries, int *children, int capacity); // Buffers hold capacity entries/ints
+RGLAYOUTAPI void RGLHitIndexReset(RGLHitIndex *index);                        // Drop recorded entries
+RGLAYOUTAPI void RGLHitIndexBuild(RGLHitIndex *index);                        // Group children per container (O(n))
+RGLAYOUTAPI int RGLHitTest(const RGLHitIndex *index, float x, float y);       // Deepest entry containing (x, y), -1: none
+RGLAYOUTAPI unsigned int RGLHitTestTag(const RGLHitIndex *index, float x, float y); // Tag of the deepest tagged entry containing (x, y)
+RGLAYOUTAPI void RGLSetHitIndex(RGLHitIndex *index);                          // Record into index (NULL: disable)
+RGLAYOUTAPI void RGLSetHitIndexCtx(RGLContext *ctx, RGLHitIndex *index);
+RGLAYOUTAPI void GuiLayoutSetNextTag(unsigned int tag);                       // Tag the next recorded rect or container
+RGLAYOUTAPI void GuiLayoutSetNextTagCtx(RGLContext *ctx, unsigned int tag);
+
+// Command buffer: append every produced rect (rect, tag, depth, container) for batched rendering
+// NOTE: RGLBeginFrame() resets the context's buffer, commands stay valid until the next frame
+RGLAYOUTAPI void RGLCommandBufferInit(RGLCommandBuffer *buffer, RGLCommand *commands, int capacity);
+RGLAYOUTAPI void RGLCommandBufferReset(RGLCommandBuffer *buffer);              // Drop recorded commands
+RGLAYOUTAPI void RGLSetCommandBuffer(RGLCommandBuffer *buffer);                // Record into buffer (NULL: disable)
+RGLAYOUTAPI void RGLSetCommandBufferCtx(RGLContext *ctx, RGLCommandBuffer *buffer);
+
+// Damage tracking: redraw only what changed since the previous frame (rects keyed by tag, else by ID)
+// NOTE: RGLBeginFrame() starts a new frame, call RGLDamageBuild() after the layout pass
+RGLAYOUTAPI void RGLDamageInit(RGLDamage *damage, RGLDamageEntry *entries, int capacity); // entries holds 3*capacity (two frames and sort scratch)
+RGLAYOUTAPI void RGLDamageReset(RGLDamage *damage);                            // Drop this frame's rects and damage (previous frame is kept)
+RGLAYOUTAPI void RGLDamageInvalidate(RGLDamage *damage);                       // Next build reports full damage (e.g. window resized)
+RGLAYOUTAPI void RGLDamageAddRect(RGLDamage *damage, Rectangle rect);          // Flag an area as damaged this frame
+RGLAYOUTAPI int RGLDamageBuild(RGLDamage *damage);                             // Diff with the previous frame, returns dirty_count
+RGLAYOUTAPI void RGLSetDamage(RGLDamage *damage);                              // Record into damage (NULL: disable)
+RGLAYOUTAPI void RGLSetDamageCtx(RGLContext *ctx, RGLDamage *damage);
+RGLAYOUTAPI void GuiLayoutMarkDirty(void);                                     // Flag the last produced rect (e.g. its text changed)
+RGLAYOUTAPI void GuiLayoutMarkDirtyCtx(RGLContext *ctx);
+
+// Zone tracing: every GuiBegin*/GuiLayoutEnd pair becomes a zone, exported as Chrome trace-event JSON
+// NOTE: Zones are recorded only with RGLAYOUT_ENABLE_TRACE, give each thread's context its own buffer
+RGLAYOUTAPI void RGLTraceInit(RGLTraceBuffer *buffer, RGLTraceEvent *events, int capacity, int thread_id); // capacity is rounded down to a power of two, capacity - 1 zones are exportable
+RGLAYOUTAPI void RGLSetTrace(RGLTraceBuffer *buffer);                         // Record zones into buffer (NULL: disable)
+RGLAYOUTAPI void RGLSetTraceCtx(RGLContext *ctx, RGLTraceBuffer *buffer);
+RGLAYOUTAPI void GuiLayoutSetNextZone(const char *name);                      // Name the next container's zone (string must outlive the export)
+RGLAYOUTAPI void GuiLayoutSetNextZoneCtx(RGLContext *ctx, const char *name);
+RGLAYOUTAPI bool RGLTraceExport(RGLTraceBuffer *const *buffers, int count, const char *fileName); // Write zones not exported yet (chrome://tracing, Perfetto)
+
+// Record and replay: log every Begin/Rec/End call with its arguments and rects, then feed the log
+// back through the API headless (benchmarks, bisecting, checking optimizations are bit-identical)
+// NOTE: Calls are logged only with RGLAYOUT_ENABLE_RECORD, after argument defaults are applied.
+// scratch holds long plans, scroll indices and batch outputs during replay, reset every frame
+RGLAYOUTAPI void RGLRecorderInit(RGLRecorder *recorder, void *memory, size_t capacity); // Start a log in caller memory
+RGLAYOUTAPI void RGLRecorderReset(RGLRecorder *recorder);                     // Drop logged calls (keeps the header)
+RGLAYOUTAPI void RGLSetRecorder(RGLRecorder *recorder);                       // Log calls into recorder (NULL: disable)
+RGLAYOUTAPI void RGLSetRecorderCtx(RGLContext *ctx, RGLRecorder *recorder);
+RGLAYOUTAPI RGLReplayResult RGLReplay(const void *log, size_t size, RGLArena *scratch); // Replay and compare every rect
+RGLAYOUTAPI RGLReplayResult RGLReplayCtx(RGLContext *ctx, const void *log, size_t size, RGLArena *scratch);
 
 // Convenience functions
 RGLAYOUTAPI Rectangle GuiLayoutPanel(float main, float cross, float pad_top, float pad_other, RGLPad *out_pad);
+RGLAYOUTAPI Rectangle GuiLayoutPanelCtx(RGLContext *ctx, float main, float cross, float pad_top, float pad_other, RGLPad *out_pad);
+
+// Deferred layout tree (retained mode): record Begin/Rec/End, solve once, read rects by handle
+// NOTE: Sizes follow GuiLayoutRec (main along parent axis), plus RGL_FIT; fill children share leftover space equally.
+// Root nodes are placed in the solve bounds with main as width and cross as height
+RGLAYOUTAPI void RGLTreeBegin(RGLTree *tree, RGLNode *nodes, int capacity);                  // Start recording (resets the arena), copies current context defaults
+RGLAYOUTAPI void RGLTreeBeginCtx(RGLContext *ctx, RGLTree *tree, RGLNode *nodes, int capacity); // Copies ctx defaults (trees are then solved without a context)
+RGLAYOUTAPI RGLNodeId RGLTreeBeginRow(RGLTree *tree, float main, float cross);               // Uses defaults
+RGLAYOUTAPI RGLNodeId RGLTreeBeginRowEx(RGLTree *tree, float main, float cross, RGLPad pad, float gap);
+RGLAYOUTAPI RGLNodeId RGLTreeBeginColumn(RGLTree *tree, float main, float cross);            // Uses defaults
+RGLAYOUTAPI RGLNodeId RGLTreeBeginColumnEx(RGLTree *tree, float main, float cross, RGLPad pad, float gap);
+RGLAYOUTAPI void RGLTreeEnd(RGLTree *tree);
+RGLAYOUTAPI RGLNodeId RGLTreeRec(RGLTree *tree, float main, float cross);                    // Leaf
+RGLAYOUTAPI RGLNodeId RGLTreeRecContent(RGLTree *tree, float main, float cross, float content_w, float content_h); // Leaf with intrinsic size for RGL_FIT
+RGLAYOUTAPI void RGLTreeSolve(RGLTree *tree, Rectangle bounds);                              // Measure (bottom-up) + arrange (top-down)
+RGLAYOUTAPI int RGLTreeSolveIncremental(RGLTree *tree, Rectangle bounds);                    // Re-arrange only containers whose rect changed, returns nodes placed
+RGLAYOUTAPI Rectangle RGLTreeRect(const RGLTree *tree, RGLNodeId node);                      // Solved rectangle
+RGLAYOUTAPI Rectangle RGLTreeContentSize(const RGLTree *tree, RGLNodeId node);               // Measured content size (x, y unused)
+
+// Parallel tree solve: sibling subtrees are arranged on a work-stealing pool, results are bit-identical to RGLTreeSolve()
+RGLAYOUTAPI bool RGLThreadPoolInit(RGLThreadPool *pool, int threads);                        // threads: workers besides the caller, false if unsupported (nothing to close)
+RGLAYOUTAPI void RGLThreadPoolClose(RGLThreadPool *pool);                                    // Stop and join workers (safe after a failed Init or a second Close)
+RGLAYOUTAPI void RGLThreadPoolSetThresholds(RGLThreadPool *pool, int min_nodes, int task_nodes);
+RGLAYOUTAPI void RGLTreeSolveParallel(RGLTree *tree, Rectangle bounds, RGLThreadPool *pool); // pool NULL: serial
 
 #endif // RGLAYOUT_H
 
@@ -166,195 +890,917 @@ RGLAYOUTAPI Rectangle GuiLayoutPanel(float main, float cross, float pad_top, flo
 
 #ifdef RGLAYOUT_IMPLEMENTATION
 
+#include <float.h>  // Required for: FLT_MAX
+#include <stdint.h> // Required for: uintptr_t
 #include <string.h>
 
-// ===== GLOBAL DEFAULTS & STATE =====
+// Thread-local storage for the current context pointer
+#if defined(RGLAYOUT_NO_THREAD_LOCAL)
+    #define RGL_THREAD_LOCAL
+#elif defined(_MSC_VER)
+    #define RGL_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+    #define RGL_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+    #define RGL_THREAD_LOCAL __thread
+#else
+    #define RGL_THREAD_LOCAL
+#endif
+
+// Restrict qualifier for non-aliasing output arrays (lets compilers vectorize batch loops)
+#if defined(__cplusplus) || defined(_MSC_VER)
+    #define RGL_RESTRICT __restrict
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L)
+    #define RGL_RESTRICT restrict
+#else
+    #define RGL_RESTRICT
+#endif
+
+// Instrumentation: counters compile to nothing unless RGLAYOUT_ENABLE_STATS is defined
+#if defined(RGLAYOUT_ENABLE_STATS)
+    #define RGL_STAT_ADD(ctx, field, n) ((ctx)->stats.field += (n))
+    #define RGL_STAT_MAX(ctx, field, v) ((ctx)->stats.field = ((v) > (ctx)->stats.field) ? (v) : (ctx)->stats.field)
+#else
+    #define RGL_STAT_ADD(ctx, field, n) ((void)0)
+    #define RGL_STAT_MAX(ctx, field, v) ((void)0)
+#endif
 
-// Private default values
-static RGLPad g_default_pad = {10, 10, 10, 10};
-static RGLVAlign g_default_valign = RGL_VALIGN_CENTER;
-static float g_default_gap = 10.0f;
+// Cycle counter for RGLAYOUT_STATS_TIMING (define RGL_STATS_CLOCK() to provide another one)
+#if defined(RGLAYOUT_ENABLE_STATS) && defined(RGLAYOUT_STATS_TIMING) && !defined(RGL_STATS_CLOCK)
+    #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        #include <intrin.h> // Required for: __rdtsc()
+        #define RGL_STATS_CLOCK() __rdtsc()
+    #elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        #include <x86intrin.h> // Required for: __rdtsc()
+        #define RGL_STATS_CLOCK() __rdtsc()
+    #endif
+#endif
 
-// The global layout state
-static RGLState g_rgl = {0};
+#if defined(RGLAYOUT_ENABLE_STATS) && defined(RGLAYOUT_STATS_TIMING) && defined(RGL_STATS_CLOCK)
+    #define RGL_STAT_CLOCK(t) unsigned long long t = (unsigned long long)RGL_STATS_CLOCK()
+    #define RGL_STAT_CYCLES(ctx, field, t) ((ctx)->stats.field += (unsigned long long)RGL_STATS_CLOCK() - (t))
+#else
+    #define RGL_STAT_CLOCK(t)
+    #define RGL_STAT_CYCLES(ctx, field, t) ((void)0)
+#endif
 
-// New: store last returned rectangle
-static Rectangle g_last_rect = {0};
+// Zone tracing compiles to nothing unless RGLAYOUT_ENABLE_TRACE is defined
+// NOTE: Define RGL_TRACE_CLOCK() to provide a nanosecond timestamp (default: monotonic clock if available)
+#if defined(RGLAYOUT_ENABLE_TRACE)
+    #include <stdio.h> // Required for: FILE, fopen(), fprintf(), fclose()
+    #include <time.h>  // Required for: clock_gettime(), timespec_get(), clock()
+    #if defined(_MSC_VER)
+        #include <intrin.h> // Required for: _ReadWriteBarrier()
+    #endif
+    #define RGL_TRACE_BEGIN(ctx, c) (((ctx)->trace != NULL) ? trace_begin((ctx), (c)) : (void)0)
+    #define RGL_TRACE_END(ctx) (((ctx)->trace != NULL) ? trace_end(ctx) : (void)0)
+#else
+    #define RGL_TRACE_BEGIN(ctx, c) ((void)0)
+    #define RGL_TRACE_END(ctx) ((void)0)
+#endif
 
-// ===== CONFIGURATION FUNCTIONS =====
+// Call logging compiles to nothing unless RGLAYOUT_ENABLE_RECORD is defined
+#if defined(RGLAYOUT_ENABLE_RECORD)
+    #define RGL_RECORD(ctx, call) (((ctx)->recorder != NULL) ? (call) : (void)0)
+#else
+    #define RGL_RECORD(ctx, call) ((void)0)
+#endif
 
-RGLAYOUTAPI void RGLSetDefaultPadAll(float p)
+// ===== GLOBAL DEFAULTS & STATE =====
+
+// Library default values
+#define RGL_DEFAULT_PAD (RGLPad){10, 10, 10, 10}
+#define RGL_DEFAULT_GAP 10.0f
+#define RGL_DEFAULT_VALIGN RGL_VALIGN_CENTER
+#define RGL_DEFAULT_TEXT_SIZE 10.0f   // raygui DEFAULT TEXT_SIZE
+#define RGL_DEFAULT_TEXT_SPACING 1.0f // raygui DEFAULT TEXT_SPACING
+
+// The default layout context, used by threads that never called RGLSetContext()
+static RGLContext g_rgl = {
+    .default_pad = {10, 10, 10, 10},
+    .default_gap = RGL_DEFAULT_GAP,
+    .default_valign = RGL_DEFAULT_VALIGN,
+    .text_size = RGL_DEFAULT_TEXT_SIZE,
+    .text_spacing = RGL_DEFAULT_TEXT_SPACING};
+
+// Current context of the calling thread (NULL: g_rgl)
+static RGL_THREAD_LOCAL RGLContext *g_rgl_current = NULL;
+
+static inline RGLContext *rgl_ctx(void)
 {
-    g_default_pad = (RGLPad){p, p, p, p};
+    return (g_rgl_current != NULL) ? g_rgl_current : &g_rgl;
 }
 
-RGLAYOUTAPI void RGLSetDefaultPad(RGLPad p)
+// ===== CONTEXT FUNCTIONS =====
+
+RGLAYOUTAPI void RGLInitContext(RGLContext *ctx)
 {
-    g_default_pad = p;
+    if (ctx == NULL)
+        return;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->default_pad = RGL_DEFAULT_PAD;
+    ctx->default_gap = RGL_DEFAULT_GAP;
+    ctx->default_valign = RGL_DEFAULT_VALIGN;
+    ctx->text_size = RGL_DEFAULT_TEXT_SIZE;
+    ctx->text_spacing = RGL_DEFAULT_TEXT_SPACING;
 }
 
+RGLAYOUTAPI void RGLSetContext(RGLContext *ctx)
+{
+    g_rgl_current = ctx;
+}
 
-RGLAYOUTAPI void RGLSetDefaultVAlign(RGLVAlign align)
+RGLAYOUTAPI RGLContext *RGLGetContext(void)
 {
-    g_default_valign = align;
+    return rgl_ctx();
 }
 
-RGLAYOUTAPI void RGLSetDefaultGap(float g)
+RGLAYOUTAPI void RGLUnloadContext(RGLContext *ctx)
 {
-    g_default_gap = g;
+    if (ctx == NULL)
+        return;
+
+    RGLState *st = &ctx->state;
+    if (st->stack_heap && ctx->alloc_fn != NULL)
+        ctx->alloc_fn(st->stack, 0, ctx->alloc_user);
+    if (st->info_heap && ctx->alloc_fn != NULL)
+        ctx->alloc_fn(st->info, 0, ctx->alloc_user);
+    if (st->spans_heap && ctx->alloc_fn != NULL)
+        ctx->alloc_fn(st->spans, 0, ctx->alloc_user);
+
+    st->stack = NULL;
+    st->info = NULL;
+    st->spans = NULL;
+    st->stack_capacity = 0;
+    st->span_capacity = 0;
+    st->stack_heap = false;
+    st->info_heap = false;
+    st->spans_heap = false;
+    st->top = 0;
+    st->span_top = 0;
+    st->overflow_depth = 0;
 }
 
-// ===== PADDING HELPERS =====
+// ===== PLAN TOTALS =====
 
-RGLAYOUTAPI RGLPad RGLPadAll(float p)
+// Count one entry into the plan totals
+static void plan_count(RGLPlan *plan, float size)
 {
-    return (RGLPad){p, p, p, p};
+    if (size >= 20)
+    {
+        // Values >= 20 are pixel sizes
+        plan->sum_fixed += size;
+    }
+    else if (size == -1)
+    {
+        // -1 means "fill" (weight of 1)
+        plan->sum_weight += 1;
+    }
+    else if (size > 0 && size < 20)
+    {
+        // Values 0-19 are flex weights
+        plan->sum_weight += size;
+    }
 }
 
-RGLAYOUTAPI RGLPad RGLPadX(float x)
+// Hash of a plan's entries from scratch, the value the builders keep in RGLPlan.hash
+static unsigned int plan_entries_hash(const RGLPlan *plan)
 {
-    return (RGLPad){x, 0, x, 0};
+    const float *sizes = (plan->entries != NULL) ? plan->entries : plan->sizes;
+    unsigned int h = RGL__PLAN_SEED;
+    for (int i = 0; i < plan->length; i++)
+        h += RGL__ENTRY_HASH(sizes[i], i);
+    return h;
 }
 
-RGLAYOUTAPI RGLPad RGLPadY(float y)
+// Recompute totals and hash from the entries (same order as the builders, so the sums match)
+static void plan_refresh(RGLPlan *plan)
 {
-    return (RGLPad){0, y, 0, y};
+    const float *sizes = (plan->entries != NULL) ? plan->entries : plan->sizes;
+    plan->sum_fixed = 0;
+    plan->sum_weight = 0;
+    for (int i = 0; i < plan->length; i++)
+        plan_count(plan, sizes[i]);
+    plan->hash = plan_entries_hash(plan);
 }
 
-RGLAYOUTAPI RGLPad RGLPadL(float x)
+// Plan whose totals can be trusted: built plans as given, hand-filled ones (hash 0) counted into scratch
+static const RGLPlan *plan_checked(const RGLPlan *plan, RGLPlan *scratch)
 {
-    return (RGLPad){x, 0, 0, 0};
+    if (plan == NULL || plan->hash != 0 || plan->length <= 0)
+        return plan;
+
+    *scratch = *plan;
+    plan_refresh(scratch);
+    return scratch;
 }
 
-RGLAYOUTAPI RGLPad RGLPadR(float x)
+// ===== RECORD & REPLAY =====
+
+// Log header and call opcodes (one byte, followed by the call's arguments and results)
+#define RGL_LOG_MAGIC 0x524c4752u // "RGLR" on little-endian machines, byte swapped logs are rejected
+#define RGL_LOG_VERSION 2u
+#define RGL_LOG_FRAME 1  // RGLBeginFrame
+#define RGL_LOG_BEGIN 2  // axis, bounds, pad, gap, plan
+#define RGL_LOG_SCROLL 3 // axis, bounds, pad, gap, scroll, count, item_size, index
+#define RGL_LOG_GRID 4   // bounds, pad, gap, column plan, row plan
+#define RGL_LOG_FLOW 5   // bounds, pad, gap, line_size
+#define RGL_LOG_END 6
+#define RGL_LOG_REC 7    // main, cross, pl, pr, pt, pb, valign, rect
+#define RGL_LOG_RECN 8   // count, main, cross, valign, rect[count]
+#define RGL_LOG_CELL 9   // row, col, row_span, col_span, rect
+
+RGLAYOUTAPI void RGLRecorderInit(RGLRecorder *recorder, void *memory, size_t capacity)
 {
-    return (RGLPad){0, 0, x, 0};
+    memset(recorder, 0, sizeof(*recorder));
+    recorder->data = (unsigned char *)memory;
+    recorder->capacity = (memory != NULL) ? capacity : 0;
+    RGLRecorderReset(recorder);
 }
 
-// ===== UTILITY FUNCTIONS =====
+RGLAYOUTAPI void RGLRecorderReset(RGLRecorder *recorder)
+{
+    if (recorder == NULL)
+        return;
 
-// Shrink rectangle by padding on all sides
-static Rectangle shrink_rect(Rectangle r, RGLPad p)
+    unsigned int header[2] = {RGL_LOG_MAGIC, RGL_LOG_VERSION};
+    recorder->size = 0;
+    recorder->frames = 0;
+    recorder->overflow = (recorder->capacity < sizeof(header));
+    if (!recorder->overflow)
+    {
+        memcpy(recorder->data, header, sizeof(header));
+        recorder->size = sizeof(header);
+    }
+    recorder->frame_start = recorder->size;
+}
+
+RGLAYOUTAPI void RGLSetRecorderCtx(RGLContext *ctx, RGLRecorder *recorder)
 {
-    Rectangle res = r;
-    res.x += p.left;
-    res.y += p.top;
-    res.width -= (p.left + p.right);
-    res.height -= (p.top + p.bottom);
+    ctx->recorder = recorder;
+}
 
-    // Ensure non-negative dimensions
-    if (res.width < 0)
-        res.width = 0;
-    if (res.height < 0)
-        res.height = 0;
-    return res;
+#if defined(RGLAYOUT_ENABLE_RECORD)
+// Append bytes, on overflow cut the log back to the start of the current frame
+static void log_put(RGLRecorder *recorder, const void *data, size_t size)
+{
+    if (recorder->overflow)
+        return;
+    if (size > recorder->capacity - recorder->size)
+    {
+        recorder->overflow = true;
+        recorder->size = recorder->frame_start;
+        if (recorder->frames > 0)
+            recorder->frames--;
+        return;
+    }
+    memcpy(recorder->data + recorder->size, data, size);
+    recorder->size += size;
 }
 
-// Check if container flows horizontally
-static bool is_row(const RGLContainer *c)
+static void log_op(RGLRecorder *recorder, unsigned char op)
 {
-    return c->axis == RGL_AXIS_ROW;
+    log_put(recorder, &op, 1);
 }
 
-// Get the main axis size (width for rows, height for columns)
-static float main_size(Rectangle r, bool row)
+static void log_frame(RGLRecorder *recorder)
 {
-    return row ? r.width : r.height;
+    if (recorder->overflow)
+        return;
+    recorder->frame_start = recorder->size;
+    recorder->frames++;
+    log_op(recorder, RGL_LOG_FRAME);
 }
 
-// Get the cross axis size (height for rows, width for columns)
-static float cross_size(Rectangle r, bool row)
+// Bounds, padding and gap shared by every Begin
+static void log_box(RGLRecorder *recorder, Rectangle bounds, RGLPad pad, float gap)
 {
-    return row ? r.height : r.width;
+    log_put(recorder, &bounds, sizeof(bounds));
+    log_put(recorder, &pad, sizeof(pad));
+    log_put(recorder, &gap, sizeof(gap));
 }
 
-// ===== CORE LAYOUT ALGORITHM =====
+// Plan with its totals and overrides as given (a NULL plan is one zero byte)
+static void log_plan(RGLRecorder *recorder, const RGLPlan *plan)
+{
+    unsigned char flags = (plan != NULL) ? (unsigned char)(1 | (plan->has_gap ? 2 : 0) | (plan->has_pad ? 4 : 0)) : 0;
+    log_put(recorder, &flags, 1);
+    if (plan == NULL)
+        return;
 
-// Initialize a container with layout parameters
-static void init_common(RGLContainer *c, Rectangle bounds, RGLAxis axis, RGLPad pad, float gap, RGLPlan plan)
+    int length = (plan->length > 0) ? plan->length : 0;
+    log_put(recorder, &length, sizeof(length));
+    log_put(recorder, &plan->sum_fixed, sizeof(float));
+    log_put(recorder, &plan->sum_weight, sizeof(float));
+    log_put(recorder, &plan->gap, sizeof(float));
+    log_put(recorder, &plan->pad, sizeof(RGLPad));
+    log_put(recorder, (plan->entries != NULL) ? plan->entries : plan->sizes, (size_t)length*sizeof(float));
+}
+
+static void log_begin(RGLRecorder *recorder, RGLAxis axis, Rectangle bounds, RGLPad pad, float gap, const RGLPlan *plan)
 {
-    // Set up container bounds and configuration
-    c->outer = bounds;
+    unsigned char kind = (unsigned char)axis;
+    log_op(recorder, RGL_LOG_BEGIN);
+    log_put(recorder, &kind, 1);
+    log_box(recorder, bounds, pad, gap);
+    log_plan(recorder, plan);
+}
 
-    // Use plan's padding if set, otherwise use provided padding
-    c->pad = plan.has_pad ? plan.pad : pad;
-    c->inner = shrink_rect(bounds, c->pad);
-    c->axis = axis;
+static void log_scroll(RGLRecorder *recorder, RGLAxis axis, Rectangle bounds, RGLPad pad, float gap, float scroll,
+                       int count, float item_size, const RGLScrollIndex *index)
+{
+    unsigned char kind = (unsigned char)axis;
+    int indexed = (index != NULL) ? index->count : -1; // Variable items: the whole index is logged
+    log_op(recorder, RGL_LOG_SCROLL);
+    log_put(recorder, &kind, 1);
+    log_box(recorder, bounds, pad, gap);
+    log_put(recorder, &scroll, sizeof(scroll));
+    log_put(recorder, &count, sizeof(count));
+    log_put(recorder, &item_size, sizeof(item_size));
+    log_put(recorder, &indexed, sizeof(indexed));
+    if (indexed >= 0)
+        log_put(recorder, index->prefix, (size_t)(indexed + 1)*sizeof(double));
+}
 
-    // Use plan's gap if set, otherwise use provided gap (which may be default)
-    c->gap = plan.has_gap ? plan.gap : gap;
+static void log_grid(RGLRecorder *recorder, Rectangle bounds, RGLPad pad, float gap, const RGLPlan *col_plan, const RGLPlan *row_plan)
+{
+    log_op(recorder, RGL_LOG_GRID);
+    log_box(recorder, bounds, pad, gap);
+    log_plan(recorder, col_plan);
+    log_plan(recorder, row_plan);
+}
 
-    // Initialize dynamic state
-    c->placed = 0;
-    c->cursor = (axis == RGL_AXIS_ROW) ? c->inner.x : c->inner.y;
-    c->remaining = (axis == RGL_AXIS_ROW) ? c->inner.width : c->inner.height;
+static void log_flow(RGLRecorder *recorder, Rectangle bounds, RGLPad pad, float gap, float line_size)
+{
+    log_op(recorder, RGL_LOG_FLOW);
+    log_box(recorder, bounds, pad, gap);
+    log_put(recorder, &line_size, sizeof(line_size));
+}
 
-    // Set up layout plan (if provided)
-    c->plan = plan;
-    c->plan_index = 0;
-    c->plan_sum_fixed = 0;
-    c->plan_sum_weight = 0;
-    c->plan_gap_total = 0;
+static void log_rec(RGLRecorder *recorder, float main, float cross, float pl, float pr, float pt, float pb,
+                    RGLVAlign valign, Rectangle result)
+{
+    float args[6] = {main, cross, pl, pr, pt, pb};
+    unsigned char align = (unsigned char)valign;
+    log_op(recorder, RGL_LOG_REC);
+    log_put(recorder, args, sizeof(args));
+    log_put(recorder, &align, 1);
+    log_put(recorder, &result, sizeof(result));
+}
 
-    // Pre-calculate plan totals for flex distribution
-    if (plan.length > 0)
+static void log_recn(RGLRecorder *recorder, int count, float main, float cross, RGLVAlign valign,
+                     const float *x, const float *y, const float *w, const float *h)
+{
+    unsigned char align = (unsigned char)valign;
+    log_op(recorder, RGL_LOG_RECN);
+    log_put(recorder, &count, sizeof(count));
+    log_put(recorder, &main, sizeof(main));
+    log_put(recorder, &cross, sizeof(cross));
+    log_put(recorder, &align, 1);
+    for (int i = 0; i < count; i++)
     {
-        float fixed_px = 0;
-        float weight_sum = 0;
+        Rectangle rect = {x[i], y[i], w[i], h[i]};
+        log_put(recorder, &rect, sizeof(rect));
+    }
+}
 
-        for (int i = 0; i < plan.length; i++)
-        {
-            float v = plan.sizes[i];
-            if (v >= 20)
-            {
-                // Values >= 20 are pixel sizes
-                fixed_px += v;
-            }
-            else if (v == -1)
-            {
-                // -1 means "fill" (weight of 1)
-                weight_sum += 1;
-            }
-            else if (v > 0 && v < 20)
-            {
-                // Values 0-19 are flex weights
-                weight_sum += v;
-            }
-        }
+static void log_cell(RGLRecorder *recorder, int row, int col, int row_span, int col_span, Rectangle result)
+{
+    int args[4] = {row, col, row_span, col_span};
+    log_op(recorder, RGL_LOG_CELL);
+    log_put(recorder, args, sizeof(args));
+    log_put(recorder, &result, sizeof(result));
+}
+#endif
 
-        // Pre-calculate gap total - use the actual gap that will be used
-        float gaps = (plan.length > 1) ? (plan.length - 1) * c->gap : 0;
+// Log reader, a short read zeroes the destination and marks the log invalid
+typedef struct RGLLogReader
+{
+    const unsigned char *at;
+    const unsigned char *end;
+    RGLArena *scratch;
+    bool ok;
+} RGLLogReader;
 
-        c->plan_sum_fixed = fixed_px;
-        c->plan_sum_weight = weight_sum;
-        c->plan_gap_total = gaps;
+static void log_get(RGLLogReader *reader, void *data, size_t size)
+{
+    if (!reader->ok || size > (size_t)(reader->end - reader->at))
+    {
+        reader->ok = false;
+        memset(data, 0, size);
+        return;
     }
+    memcpy(data, reader->at, size);
+    reader->at += size;
 }
 
-// Allocate the next rectangle in the current container
-static Rectangle take_rect(RGLContainer *c, float main, float cross)
+// Variable-length array copied into scratch (logged values may be unaligned)
+static void *log_get_array(RGLLogReader *reader, size_t size)
 {
-    bool row = is_row(c);
+    void *data = RGLArenaAlloc(reader->scratch, (size > 0) ? size : 1);
+    if (data == NULL)
+    {
+        reader->ok = false;
+        return NULL;
+    }
+    log_get(reader, data, size);
+    return reader->ok ? data : NULL;
+}
 
-    // Add gap before this element (except for the first one)
-    if (c->placed > 0 && c->gap > 0)
+// Rebuild a logged plan into plan (NULL: no plan was given)
+static const RGLPlan *log_get_plan(RGLLogReader *reader, RGLPlan *plan)
+{
+    unsigned char flags = 0;
+    log_get(reader, &flags, 1);
+    if (!(flags & 1))
+        return NULL;
+
+    memset(plan, 0, sizeof(*plan));
+    log_get(reader, &plan->length, sizeof(plan->length));
+    log_get(reader, &plan->sum_fixed, sizeof(float));
+    log_get(reader, &plan->sum_weight, sizeof(float));
+    log_get(reader, &plan->gap, sizeof(float));
+    log_get(reader, &plan->pad, sizeof(RGLPad));
+    plan->has_gap = (flags & 2) != 0;
+    plan->has_pad = (flags & 4) != 0;
+    if (plan->length < 0)
+        reader->ok = false;
+    else if (plan->length <= RGL_PLAN_MAX)
+        log_get(reader, plan->sizes, (size_t)plan->length*sizeof(float));
+    else
     {
-        c->cursor += c->gap;
-        // Only consume gap from 'remaining' in ad-hoc mode
-        if (c->plan.length == 0)
-        {
-            c->remaining -= c->gap;
-        }
+        plan->entries = (float *)log_get_array(reader, (size_t)plan->length*sizeof(float));
+        plan->capacity = plan->length;
     }
+    if (reader->ok)
+        plan->hash = plan_entries_hash(plan);
+    return plan;
+}
 
-    // Clamp main axis size to available space
-    float m = main;
-    if (m > c->remaining)
-        m = c->remaining;
-    if (m < 0)
-        m = 0;
+// Compare a replayed rect with the logged one, bit for bit
+static void log_check(RGLLogReader *reader, RGLReplayResult *result, size_t offset, Rectangle rect)
+{
+    Rectangle logged;
+    log_get(reader, &logged, sizeof(logged));
+    if (!reader->ok)
+        return;
 
-    // Handle cross axis sizing
+    result->rects++;
+    if (memcmp(&logged, &rect, sizeof(rect)) != 0)
+    {
+        if (result->mismatches == 0)
+            result->first_mismatch = offset;
+        result->mismatches++;
+    }
+}
+
+RGLAYOUTAPI RGLReplayResult RGLReplayCtx(RGLContext *ctx, const void *log, size_t size, RGLArena *scratch)
+{
+    RGLReplayResult result = {0};
+    RGLLogReader reader = {(const unsigned char *)log, (const unsigned char *)log + size, scratch, log != NULL};
+
+    unsigned int header[2] = {0, 0};
+    log_get(&reader, header, sizeof(header));
+    if (header[0] != RGL_LOG_MAGIC || header[1] != RGL_LOG_VERSION)
+        return result;
+
+    while (reader.ok && reader.at < reader.end)
+    {
+        size_t offset = (size_t)(reader.at - (const unsigned char *)log);
+        unsigned char op = 0, kind = 0;
+        Rectangle bounds;
+        RGLPad pad;
+        float gap;
+        RGLPlan plans[2];
+        log_get(&reader, &op, 1);
+
+        switch (op)
+        {
+        case RGL_LOG_FRAME:
+        {
+            RGLArenaReset(scratch);
+            RGLBeginFrameCtx(ctx);
+            result.frames++;
+        } break;
+        case RGL_LOG_BEGIN:
+        {
+            log_get(&reader, &kind, 1);
+            log_get(&reader, &bounds, sizeof(bounds));
+            log_get(&reader, &pad, sizeof(pad));
+            log_get(&reader, &gap, sizeof(gap));
+            const RGLPlan *plan = log_get_plan(&reader, &plans[0]);
+            if (!reader.ok)
+                break;
+            if (kind == RGL_AXIS_ROW)
+                GuiBeginRowExCtx(ctx, bounds, pad, gap, plan);
+            else
+                GuiBeginColumnExCtx(ctx, bounds, pad, gap, plan);
+        } break;
+        case RGL_LOG_SCROLL:
+        {
+            float scroll, item_size;
+            int count, indexed;
+            log_get(&reader, &kind, 1);
+            log_get(&reader, &bounds, sizeof(bounds));
+            log_get(&reader, &pad, sizeof(pad));
+            log_get(&reader, &gap, sizeof(gap));
+            log_get(&reader, &scroll, sizeof(scroll));
+            log_get(&reader, &count, sizeof(count));
+            log_get(&reader, &item_size, sizeof(item_size));
+            log_get(&reader, &indexed, sizeof(indexed));
+            RGLScrollIndex index = {NULL, indexed};
+            if (reader.ok && indexed >= 0)
+                index.prefix = (double *)log_get_array(&reader, (size_t)(indexed + 1)*sizeof(double));
+            if (!reader.ok)
+                break;
+            if (kind == RGL_AXIS_ROW)
+                GuiBeginScrollRowExCtx(ctx, bounds, pad, gap, scroll, count, item_size, (indexed >= 0) ? &index : NULL);
+            else
+                GuiBeginScrollColumnExCtx(ctx, bounds, pad, gap, scroll, count, item_size, (indexed >= 0) ? &index : NULL);
+        } break;
+        case RGL_LOG_GRID:
+        {
+            log_get(&reader, &bounds, sizeof(bounds));
+            log_get(&reader, &pad, sizeof(pad));
+            log_get(&reader, &gap, sizeof(gap));
+            const RGLPlan *col_plan = log_get_plan(&reader, &plans[0]);
+            const RGLPlan *row_plan = log_get_plan(&reader, &plans[1]);
+            if (reader.ok)
+                GuiBeginGridExCtx(ctx, bounds, pad, gap, col_plan, row_plan);
+        } break;
+        case RGL_LOG_FLOW:
+        {
+            float line_size;
+            log_get(&reader, &bounds, sizeof(bounds));
+            log_get(&reader, &pad, sizeof(pad));
+            log_get(&reader, &gap, sizeof(gap));
+            log_get(&reader, &line_size, sizeof(line_size));
+            if (reader.ok)
+                GuiBeginFlowExCtx(ctx, bounds, pad, gap, line_size);
+        } break;
+        case RGL_LOG_END:
+        {
+            GuiLayoutEndCtx(ctx);
+        } break;
+        case RGL_LOG_REC:
+        {
+            float args[6];
+            unsigned char align;
+            log_get(&reader, args, sizeof(args));
+            log_get(&reader, &align, 1);
+            if (!reader.ok)
+                break;
+            Rectangle rect = GuiLayoutRecExCtx(ctx, args[0], args[1], args[2], args[3], args[4], args[5], (RGLVAlign)align);
+            log_check(&reader, &result, offset, rect);
+        } break;
+        case RGL_LOG_RECN:
+        {
+            int count;
+            float main, cross;
+            unsigned char align;
+            log_get(&reader, &count, sizeof(count));
+            log_get(&reader, &main, sizeof(main));
+            log_get(&reader, &cross, sizeof(cross));
+            log_get(&reader, &align, 1);
+            float *out = (reader.ok && count > 0) ? (float *)RGLArenaAlloc(scratch, 4*(size_t)count*sizeof(float)) : NULL;
+            if (out == NULL)
+            {
+                reader.ok = false; // Batches are never empty, a NULL out means scratch ran out
+                break;
+            }
+
+            // The batch aligns with the context default, use the recording app's
+            RGLVAlign valign = ctx->default_valign;
+            ctx->default_valign = (RGLVAlign)align;
+            GuiLayoutRecNCtx(ctx, count, main, cross, out, out + count, out + 2*count, out + 3*count);
+            ctx->default_valign = valign;
+            for (int i = 0; i < count; i++)
+                log_check(&reader, &result, offset, (Rectangle){out[i], out[count + i], out[2*count + i], out[3*count + i]});
+        } break;
+        case RGL_LOG_CELL:
+        {
+            int args[4];
+            log_get(&reader, args, sizeof(args));
+            if (!reader.ok)
+                break;
+            Rectangle rect = GuiLayoutCellSpanCtx(ctx, args[0], args[1], args[2], args[3]);
+            log_check(&reader, &result, offset, rect);
+        } break;
+        default:
+            reader.ok = false;
+            break;
+        }
+        if (reader.ok)
+            result.calls += (op != RGL_LOG_FRAME) ? 1 : 0;
+    }
+
+    result.valid = reader.ok;
+    return result;
+}
+
+// ===== FRAME & MEMORY FUNCTIONS =====
+
+RGLAYOUTAPI void RGLArenaInit(RGLArena *arena, void *memory, size_t size)
+{
+    arena->base = (unsigned char *)memory;
+    arena->size = (memory != NULL) ? size : 0;
+    arena->used = 0;
+}
+
+RGLAYOUTAPI void RGLArenaReset(RGLArena *arena)
+{
+    if (arena != NULL)
+        arena->used = 0;
+}
+
+RGLAYOUTAPI void *RGLArenaAlloc(RGLArena *arena, size_t size)
+{
+    if (arena == NULL || arena->base == NULL)
+        return NULL;
+
+    uintptr_t at = (uintptr_t)(arena->base + arena->used);
+    size_t pad = (size_t)((RGL_ARENA_ALIGN - (at & (RGL_ARENA_ALIGN - 1))) & (RGL_ARENA_ALIGN - 1));
+    if (pad > arena->size - arena->used || size > arena->size - arena->used - pad)
+        return NULL;
+
+    void *block = arena->base + arena->used + pad;
+    arena->used += pad + size;
+    return block;
+}
+
+RGLAYOUTAPI void RGLSetArenaCtx(RGLContext *ctx, RGLArena *arena)
+{
+    ctx->arena = arena;
+}
+
+RGLAYOUTAPI void RGLSetAllocatorCtx(RGLContext *ctx, RGLReallocFunc alloc_fn, void *user)
+{
+    ctx->alloc_fn = alloc_fn;
+    ctx->alloc_user = user;
+}
+
+RGLAYOUTAPI void RGLBeginFrameCtx(RGLContext *ctx)
+{
+    RGLState *st = &ctx->state;
+    RGL_RECORD(ctx, log_frame(ctx->recorder));
+
+    ctx->last_stats = ctx->stats;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+
+    // Previous frame left containers open: report it, then start from an empty stack anyway
+    ctx->errors = (st->top != 0 || st->overflow_depth != 0) ? RGL_ERROR_UNBALANCED : RGL_ERROR_NONE;
+    st->top = 0;
+    st->span_top = 0;
+    st->overflow_depth = 0;
+    ctx->next_id = 0;
+
+    // Arena blocks die with the frame, heap blocks are kept for the next one
+    if (!st->stack_heap)
+    {
+        st->stack = st->inline_stack;
+        st->stack_capacity = RGL_MAX_STACK;
+    }
+    if (!st->info_heap)
+        st->info = st->inline_info; // Never smaller than stack: info grows first
+    if (!st->spans_heap)
+    {
+        st->spans = st->inline_spans;
+        st->span_capacity = RGL_SPAN_MAX;
+    }
+    RGLArenaReset(ctx->arena);
+    RGLHitIndexReset(ctx->hit);
+    RGLCommandBufferReset(ctx->commands);
+    RGLDamageReset(ctx->damage);
+    ctx->next_tag = 0;
+    ctx->next_key = 0;
+    ctx->root_nested = 0;
+    ctx->last_parent = 0;
+    ctx->next_zone = NULL;
+    if (ctx->trace != NULL)
+        ctx->trace->open = 0;
+}
+
+RGLAYOUTAPI int RGLGetErrorsCtx(RGLContext *ctx)
+{
+    return ctx->errors;
+}
+
+RGLAYOUTAPI RGLFrameStats RGLGetFrameStatsCtx(RGLContext *ctx)
+{
+    return ctx->last_stats;
+}
+
+// ===== CONFIGURATION FUNCTIONS =====
+
+RGLAYOUTAPI void RGLSetDefaultPadAllCtx(RGLContext *ctx, float p)
+{
+    ctx->default_pad = (RGLPad){p, p, p, p};
+}
+
+RGLAYOUTAPI void RGLSetDefaultPadCtx(RGLContext *ctx, RGLPad p)
+{
+    ctx->default_pad = p;
+}
+
+RGLAYOUTAPI void RGLSetDefaultVAlignCtx(RGLContext *ctx, RGLVAlign align)
+{
+    ctx->default_valign = align;
+}
+
+RGLAYOUTAPI void RGLSetDefaultGapCtx(RGLContext *ctx, float g)
+{
+    ctx->default_gap = g;
+}
+
+RGLAYOUTAPI void RGLSetDefaultPadAll(float p)
+{
+    RGLSetDefaultPadAllCtx(rgl_ctx(), p);
+}
+
+RGLAYOUTAPI void RGLSetDefaultPad(RGLPad p)
+{
+    RGLSetDefaultPadCtx(rgl_ctx(), p);
+}
+
+RGLAYOUTAPI void RGLSetDefaultVAlign(RGLVAlign align)
+{
+    RGLSetDefaultVAlignCtx(rgl_ctx(), align);
+}
+
+RGLAYOUTAPI void RGLSetDefaultGap(float g)
+{
+    RGLSetDefaultGapCtx(rgl_ctx(), g);
+}
+
+// ===== PADDING HELPERS =====
+
+RGLAYOUTAPI RGLPad RGLPadAll(float p)
+{
+    return (RGLPad){p, p, p, p};
+}
+
+RGLAYOUTAPI RGLPad RGLPadX(float x)
+{
+    return (RGLPad){x, 0, x, 0};
+}
+
+RGLAYOUTAPI RGLPad RGLPadY(float y)
+{
+    return (RGLPad){0, y, 0, y};
+}
+
+RGLAYOUTAPI RGLPad RGLPadL(float x)
+{
+    return (RGLPad){x, 0, 0, 0};
+}
+
+RGLAYOUTAPI RGLPad RGLPadR(float x)
+{
+    return (RGLPad){0, 0, x, 0};
+}
+
+// ===== UTILITY FUNCTIONS =====
+
+// Shrink rectangle by padding on all sides
+static Rectangle shrink_rect(Rectangle r, RGLPad p)
+{
+    Rectangle res = r;
+    res.x += p.left;
+    res.y += p.top;
+    res.width -= (p.left + p.right);
+    res.height -= (p.top + p.bottom);
+
+    // Ensure non-negative dimensions
+    if (res.width < 0)
+        res.width = 0;
+    if (res.height < 0)
+        res.height = 0;
+    return res;
+}
+
+// Check if container flows horizontally
+static bool is_row(const RGLContainer *c)
+{
+    return c->axis == RGL_AXIS_ROW;
+}
+
+// Get the main axis size (width for rows, height for columns)
+static float main_size(Rectangle r, bool row)
+{
+    return row ? r.width : r.height;
+}
+
+// Get the cross axis size (height for rows, width for columns)
+static float cross_size(Rectangle r, bool row)
+{
+    return row ? r.height : r.width;
+}
+
+// ===== CORE LAYOUT ALGORITHM =====
+
+// Initialize a container with layout parameters
+// NOTE: The plan is only read here (by reference), it is never copied into the container
+static void init_common(RGLContainer *c, Rectangle bounds, RGLAxis axis, RGLPad pad, float gap, const RGLPlan *plan)
+{
+    // Set up container bounds and configuration
+    c->outer = bounds;
+
+    // Use plan's padding if set, otherwise use provided padding
+    c->inner = shrink_rect(bounds, (plan != NULL && plan->has_pad) ? plan->pad : pad);
+    c->axis = axis;
+
+    // Use plan's gap if set, otherwise use provided gap (which may be default)
+    c->gap = (plan != NULL && plan->has_gap) ? plan->gap : gap;
+
+    // Initialize dynamic state
+    c->placed = 0;
+    c->cursor = (axis == RGL_AXIS_ROW) ? c->inner.x : c->inner.y;
+    c->remaining = (axis == RGL_AXIS_ROW) ? c->inner.width : c->inner.height;
+
+    // Set up layout plan progress (spans are resolved by resolve_plan)
+    c->columns = 0;
+    c->plan_length = (plan != NULL) ? plan->length : 0;
+    c->span_base = 0;
+}
+
+// Plan entries (inline or external storage)
+static const float *plan_sizes(const RGLPlan *plan)
+{
+    return (plan->entries != NULL) ? plan->entries : plan->sizes;
+}
+
+// Resolve main-axis spans for every plan entry
+// NOTE: Replays the cursor/remaining sequence of take_rect(), so results match per-call resolution
+static void resolve_plan(const RGLContainer *c, const RGLPlan *plan, RGLSpan *out)
+{
+    if (c->plan_length <= 0)
+        return;
+
+    // Plan totals for flex distribution, summed by the builders as entries were added
+    const float *sizes = plan_sizes(plan);
+    float fixed_px = plan->sum_fixed;
+    float weight_sum = plan->sum_weight;
+
+    // Pre-calculate gap total - use the actual gap that will be used
+    float gaps = (c->plan_length > 1) ? (c->plan_length - 1) * c->gap : 0;
+
+    float space_for_flex = main_size(c->inner, is_row(c)) - fixed_px - gaps;
+    if (space_for_flex < 0)
+        space_for_flex = 0;
+
+    float cursor = c->cursor;
+    float remaining = c->remaining;
+
+    for (int i = 0; i < c->plan_length; i++)
+    {
+        float v = sizes[i];
+        float main_px;
+
+        if (v >= 20)
+        {
+            // Fixed pixel size
+            main_px = v;
+        }
+        else if (v == -1)
+        {
+            // Fill remaining space (flex weight of 1)
+            main_px = (weight_sum > 0) ? (1.0f / weight_sum) * space_for_flex : space_for_flex;
+        }
+        else if (v > 0 && v < 20)
+        {
+            // Flex weight (0-19)
+            main_px = (weight_sum > 0) ? (v / weight_sum) * space_for_flex : 0;
+        }
+        else
+        {
+            // Values < -1 are ignored, treated as 0 size
+            main_px = 0;
+        }
+
+        // Gap before every element but the first (not consumed from 'remaining' in planned mode)
+        if (i > 0 && c->gap > 0)
+            cursor += c->gap;
+
+        // Clamp main axis size to available space
+        float m = main_px;
+        if (m > remaining)
+            m = remaining;
+        if (m < 0)
+            m = 0;
+
+        out[i] = (RGLSpan){cursor, m};
+        cursor += m;
+        remaining -= m;
+    }
+}
+
+// Build a child rectangle from a main-axis span, filling or clamping the cross axis
+static Rectangle span_rect(const RGLContainer *c, float offset, float m, float cross)
+{
+    bool row = is_row(c);
+
+    // Handle cross axis sizing
     float cross_fill = cross_size(c->inner, row);
     float cr = cross;
     if (cr < 0)
@@ -362,250 +1808,3081 @@ static Rectangle take_rect(RGLContainer *c, float main, float cross)
     if (cr > cross_fill)
         cr = cross_fill; // Clamp to available space
 
-    // Create the rectangle based on layout direction
-    Rectangle r;
-    if (row)
+    // Create the rectangle based on layout direction
+    if (row)
+    {
+        // Horizontal layout
+        return (Rectangle){
+            .x = offset,
+            .y = c->inner.y,
+            .width = m,
+            .height = cr};
+    }
+
+    // Vertical layout
+    return (Rectangle){
+        .x = c->inner.x,
+        .y = offset,
+        .width = cr,
+        .height = m};
+}
+
+// Allocate the next rectangle in the current container
+static Rectangle take_rect(RGLContainer *c, float main, float cross)
+{
+    // Add gap before this element (except for the first one)
+    if (c->placed > 0 && c->gap > 0)
+    {
+        c->cursor += c->gap;
+        // Only consume gap from 'remaining' in ad-hoc mode
+        if (c->plan_length == 0)
+        {
+            c->remaining -= c->gap;
+        }
+    }
+
+    // Clamp main axis size to available space
+    float m = main;
+    if (m > c->remaining)
+        m = c->remaining;
+    if (m < 0)
+        m = 0;
+
+    Rectangle r = span_rect(c, c->cursor, m, cross);
+    c->cursor += m;
+    c->remaining -= m;
+
+    c->placed++;
+    return r;
+}
+
+// Resolved spans of an open container: its block of the span stack, or its cache entry
+static const RGLSpan *container_spans(const RGLState *st, const RGLContainer *c)
+{
+    return (c->span_base >= 0) ? &st->spans[c->span_base] : st->info[c - st->stack].spans;
+}
+
+// Allocate the next planned rectangle from its pre-resolved span
+static Rectangle take_span(RGLContainer *c, RGLSpan span, float cross)
+{
+    Rectangle r = span_rect(c, span.offset, span.size, cross);
+    c->cursor = span.offset + span.size;
+    c->remaining -= span.size;
+
+    c->placed++;
+    return r;
+}
+
+// ===== LAYOUT CACHE =====
+
+static bool rect_equal(Rectangle a, Rectangle b)
+{
+    return (a.x == b.x) && (a.y == b.y) && (a.width == b.width) && (a.height == b.height);
+}
+
+// Whether an open container reads its spans from this entry (it must not be rewritten before End)
+static bool cache_entry_open(const RGLState *st, const RGLCacheEntry *e)
+{
+    for (int i = 0; i < st->top; i++)
+    {
+        if (st->stack[i].span_base < 0 && st->info[i].spans == e->spans)
+            return true;
+    }
+    return false;
+}
+
+// Find the container's spans in the cache, or resolve them into its entry
+// NOTE: Entries are found by ID in a small probe window, the least recently used slot is replaced.
+// The key is compared field by field, no plan entry is read on a hit. Returns NULL when the slot
+// is still read by an open container, the caller then resolves into the span stack
+static const RGLSpan *resolve_plan_cached(RGLLayoutCache *cache, const RGLState *st, unsigned int id, const RGLContainer *c, const RGLPlan *plan)
+{
+    unsigned int hash = (plan->hash != 0) ? plan->hash : plan_entries_hash(plan);
+    unsigned int slot = (id * 2654435761u) & (RGL_CACHE_SIZE - 1);
+    RGLCacheEntry *victim = &cache->entries[slot];
+
+    cache->stamp++;
+
+    for (int probe = 0; probe < RGL_CACHE_PROBE; probe++)
+    {
+        RGLCacheEntry *e = &cache->entries[(slot + probe) & (RGL_CACHE_SIZE - 1)];
+        if (e->id == id)
+        {
+            if (e->plan_hash == hash && e->length == c->plan_length && e->axis == c->axis && e->gap == c->gap &&
+                e->sum_fixed == plan->sum_fixed && e->sum_weight == plan->sum_weight &&
+                rect_equal(e->outer, c->outer) && rect_equal(e->inner, c->inner))
+            {
+                e->stamp = cache->stamp;
+                cache->hits++;
+                return e->spans;
+            }
+
+            victim = e; // Same container, inputs changed: refresh in place
+            break;
+        }
+        if (e->stamp < victim->stamp)
+            victim = e;
+    }
+
+    cache->misses++;
+    if (cache_entry_open(st, victim))
+        return NULL;
+
+    resolve_plan(c, plan, victim->spans);
+    if (victim->id != id)
+        victim->breakpoints = NULL; // Selection belonged to the evicted container
+    victim->id = id;
+    victim->plan_hash = hash;
+    victim->length = c->plan_length;
+    victim->axis = c->axis;
+    victim->sum_fixed = plan->sum_fixed;
+    victim->sum_weight = plan->sum_weight;
+    victim->gap = c->gap;
+    victim->outer = c->outer;
+    victim->inner = c->inner;
+    victim->stamp = cache->stamp;
+    return victim->spans;
+}
+
+// Entry stored for a container ID, NULL when it is not cached
+static RGLCacheEntry *cache_find(RGLLayoutCache *cache, unsigned int id)
+{
+    unsigned int slot = (id * 2654435761u) & (RGL_CACHE_SIZE - 1);
+    for (int probe = 0; probe < RGL_CACHE_PROBE; probe++)
+    {
+        RGLCacheEntry *e = &cache->entries[(slot + probe) & (RGL_CACHE_SIZE - 1)];
+        if (e->id == id)
+            return e;
+    }
+    return NULL;
+}
+
+// Index of the breakpoint covering a width: the largest min_width not above it (below every entry: the
+// smallest one). The band [*band_min, *band_max) is where that choice holds, tables need not be sorted
+static int select_breakpoint(const RGLBreakpoint *breakpoints, int count, float width, float *band_min, float *band_max)
+{
+    int selected = -1, lowest = 0;
+    float next = FLT_MAX;
+
+    for (int i = 0; i < count; i++)
+    {
+        float w = breakpoints[i].min_width;
+        if (w < breakpoints[lowest].min_width)
+            lowest = i;
+        if (w <= width && (selected < 0 || w > breakpoints[selected].min_width))
+            selected = i;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        float w = breakpoints[i].min_width;
+        if (w > width && w < next)
+            next = w;
+    }
+
+    *band_min = (selected >= 0) ? breakpoints[selected].min_width : -FLT_MAX;
+    *band_max = next;
+    return (selected >= 0) ? selected : lowest;
+}
+
+RGLAYOUTAPI void RGLSetLayoutCacheCtx(RGLContext *ctx, RGLLayoutCache *cache)
+{
+    ctx->cache = cache;
+}
+
+RGLAYOUTAPI void RGLLayoutCacheReset(RGLLayoutCache *cache)
+{
+    if (cache != NULL)
+        memset(cache, 0, sizeof(*cache));
+}
+
+RGLAYOUTAPI void GuiLayoutSetNextIdCtx(RGLContext *ctx, unsigned int id)
+{
+    ctx->next_id = id;
+}
+
+RGLAYOUTAPI unsigned int RGLHashString(const char *text)
+{
+    unsigned int h = 2166136261u;
+    if (text != NULL)
+    {
+        while (*text != '\0')
+        {
+            h = (h ^ (unsigned char)*text) * 16777619u;
+            text++;
+        }
+    }
+    return (h != 0) ? h : 1; // 0 means "no ID"
+}
+
+// ===== TEXT MEASUREMENT =====
+
+RGLAYOUTAPI void RGLSetTextMeasureCtx(RGLContext *ctx, RGLGlyphAdvanceFunc measure_fn, void *user)
+{
+    ctx->measure_fn = measure_fn;
+    ctx->measure_user = user;
+}
+
+RGLAYOUTAPI void RGLSetTextFontCtx(RGLContext *ctx, const void *font, float size, float spacing)
+{
+    ctx->text_font = font;
+    ctx->text_size = size;
+    ctx->text_spacing = spacing;
+}
+
+RGLAYOUTAPI void RGLSetTextCacheCtx(RGLContext *ctx, RGLTextCache *cache)
+{
+    ctx->text_cache = cache;
+}
+
+RGLAYOUTAPI void RGLTextCacheReset(RGLTextCache *cache)
+{
+    if (cache != NULL)
+        memset(cache, 0, sizeof(*cache));
+}
+
+// Built-in glyph metric: raylib font data, or a fixed advance when standalone
+static float glyph_advance_builtin(int codepoint, const void *font, float size, void *user)
+{
+    (void)user;
+#if defined(RGLAYOUT_STANDALONE)
+    (void)codepoint;
+    (void)font;
+    return size*0.5f;
+#else
+    Font f = (font != NULL) ? *(const Font *)font : GetFontDefault();
+    if (f.glyphs == NULL || f.baseSize <= 0)
+        return size*0.5f;
+
+    // Same advance as MeasureTextEx()
+    int index = GetGlyphIndex(f, codepoint);
+    float advance = (f.glyphs[index].advanceX != 0) ? (float)f.glyphs[index].advanceX : f.recs[index].width + (float)f.glyphs[index].offsetX;
+    return advance*size/(float)f.baseSize;
+#endif
+}
+
+// Decode one UTF-8 codepoint, invalid sequences decode as '?' (one byte)
+static int utf8_next(const unsigned char *s, int *bytes)
+{
+    int length = (s[0] < 0x80) ? 1 : ((s[0] & 0xe0) == 0xc0) ? 2 : ((s[0] & 0xf0) == 0xe0) ? 3 : ((s[0] & 0xf8) == 0xf0) ? 4 : 0;
+    int codepoint = (length == 1) ? s[0] : (length == 2) ? (s[0] & 0x1f) : (length == 3) ? (s[0] & 0x0f) : (s[0] & 0x07);
+
+    for (int i = 1; i < length; i++)
+    {
+        if ((s[i] & 0xc0) != 0x80)
+        {
+            length = 0;
+            break;
+        }
+        codepoint = (codepoint << 6) | (s[i] & 0x3f);
+    }
+
+    *bytes = (length > 0) ? length : 1;
+    return (length > 0) ? codepoint : '?';
+}
+
+// Glyph table of (font, size), the least recently used table is recycled
+static RGLGlyphTable *glyph_table(RGLTextCache *cache, const void *font, float size)
+{
+    RGLGlyphTable *victim = &cache->tables[0];
+    for (int i = 0; i < RGL_GLYPH_TABLES; i++)
+    {
+        RGLGlyphTable *t = &cache->tables[i];
+        if (t->size == size && t->font == font)
+        {
+            t->stamp = cache->stamp;
+            return t;
+        }
+        if (t->stamp < victim->stamp)
+            victim = t;
+    }
+
+    victim->font = font;
+    victim->size = size;
+    victim->stamp = cache->stamp;
+    for (int c = 0; c < RGL_GLYPH_TABLE_SIZE; c++)
+        victim->advance[c] = -1.0f;
+    return victim;
+}
+
+// Measure text with the context font (widest line, lines*size)
+static void measure_text(RGLContext *ctx, const char *text, RGLGlyphTable *table, float *out_width, float *out_height)
+{
+    RGLGlyphAdvanceFunc advance_fn = (ctx->measure_fn != NULL) ? ctx->measure_fn : glyph_advance_builtin;
+    float size = ctx->text_size;
+    float spacing = ctx->text_spacing;
+    const unsigned char *s = (const unsigned char *)text;
+
+    float width = 0.0f;
+    float line = 0.0f;
+    int glyphs = 0;
+    int lines = 1;
+    while (*s != '\0')
+    {
+        int bytes = 1;
+        int codepoint = utf8_next(s, &bytes);
+        s += bytes;
+
+        if (codepoint == '\n')
+        {
+            if (line > width)
+                width = line;
+            line = 0.0f;
+            glyphs = 0;
+            lines++;
+            continue;
+        }
+
+        float advance;
+        if (table != NULL && codepoint < RGL_GLYPH_TABLE_SIZE)
+        {
+            if (table->advance[codepoint] < 0)
+                table->advance[codepoint] = advance_fn(codepoint, ctx->text_font, size, ctx->measure_user);
+            advance = table->advance[codepoint];
+        }
+        else
+        {
+            advance = advance_fn(codepoint, ctx->text_font, size, ctx->measure_user);
+        }
+
+        line += (glyphs > 0) ? advance + spacing : advance;
+        glyphs++;
+    }
+    if (line > width)
+        width = line;
+
+    *out_width = width;
+    *out_height = (float)lines*size;
+}
+
+RGLAYOUTAPI Rectangle RGLMeasureTextCtx(RGLContext *ctx, const char *text)
+{
+    Rectangle result = {0, 0, 0, 0};
+    if (text == NULL || text[0] == '\0')
+        return result;
+
+    RGLTextCache *cache = ctx->text_cache;
+    if (cache == NULL)
+    {
+        measure_text(ctx, text, NULL, &result.width, &result.height);
+        return result;
+    }
+
+    // String hash and length in one pass (FNV-1a, as RGLHashString)
+    unsigned int hash = 2166136261u;
+    int length = 0;
+    while (text[length] != '\0')
+    {
+        hash = (hash ^ (unsigned char)text[length]) * 16777619u;
+        length++;
+    }
+    if (hash == 0)
+        hash = 1; // 0 marks empty slots
+
+    unsigned int size_bits;
+    memcpy(&size_bits, &ctx->text_size, sizeof(size_bits));
+    unsigned int key = hash ^ (unsigned int)(uintptr_t)ctx->text_font ^ (size_bits * 2654435761u);
+    unsigned int slot = (key * 2654435761u) >> 8;
+    RGLTextCacheEntry *victim = &cache->entries[slot & (RGL_TEXT_CACHE_SIZE - 1)];
+
+    cache->stamp++;
+
+    for (int probe = 0; probe < RGL_TEXT_CACHE_PROBE; probe++)
+    {
+        RGLTextCacheEntry *e = &cache->entries[(slot + probe) & (RGL_TEXT_CACHE_SIZE - 1)];
+        if (e->hash == hash && e->length == length && e->font == ctx->text_font && e->size == ctx->text_size &&
+            e->spacing == ctx->text_spacing)
+        {
+            e->stamp = cache->stamp;
+            cache->hits++;
+            result.width = e->width;
+            result.height = e->height;
+            return result;
+        }
+        if (e->stamp < victim->stamp)
+            victim = e;
+    }
+
+    measure_text(ctx, text, glyph_table(cache, ctx->text_font, ctx->text_size), &result.width, &result.height);
+    cache->misses++;
+
+    victim->hash = hash;
+    victim->length = length;
+    victim->font = ctx->text_font;
+    victim->size = ctx->text_size;
+    victim->spacing = ctx->text_spacing;
+    victim->width = result.width;
+    victim->height = result.height;
+    victim->stamp = cache->stamp;
+    return result;
+}
+
+// Fit the next rect to its text along the main axis (flows and rows: width, columns: height)
+RGLAYOUTAPI Rectangle GuiLayoutRecTextCtx(RGLContext *ctx, const char *text, float pad, float cross)
+{
+    const RGLState *st = &ctx->state;
+    Rectangle size = RGLMeasureTextCtx(ctx, text);
+    bool row = (st->top <= 0) || (st->stack[st->top - 1].axis == RGL_AXIS_ROW);
+    float main = (row ? size.width : size.height) + 2*pad;
+
+    return GuiLayoutRecExCtx(ctx, main, cross, 0.0f, 0.0f, 0.0f, 0.0f, ctx->default_valign);
+}
+
+// ===== HIERARCHICAL IDS =====
+
+// Hierarchical ID of a child: parent ID, kind (rect/container, index/key) and slot, finalized twice
+static unsigned int id_hash(unsigned int parent, unsigned int kind, unsigned int slot)
+{
+    unsigned int h = parent ^ (kind*0x9e3779b9u);
+    for (int round = 0; round < 2; round++)
+    {
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        h ^= slot;
+    }
+    return (h != 0) ? h : 1; // 0 means "no ID"
+}
+
+#define RGL_ID_ROOT 2166136261u // Parent ID of top-level containers
+
+// Assign the ID of a container about to be pushed (its parent is the current top)
+// NOTE: GuiBeginRow(GuiLayoutRec(...)) derives the container ID from its rect's ID, so keying the
+// rect keys the container and everything inside it
+static void init_id(RGLContext *ctx, RGLContainer *c)
+{
+    RGLState *st = &ctx->state;
+    RGLContainerInfo *info = &st->info[st->top];
+    RGLContainerInfo *parent = (st->top > 0) ? &st->info[st->top - 1] : NULL;
+    int index = (parent != NULL) ? parent->nested++ : ctx->root_nested++;
+    unsigned int parent_id = (parent != NULL) ? parent->id : RGL_ID_ROOT;
+
+    if (ctx->next_key != 0)
+        info->id = id_hash(parent_id, 4, ctx->next_key);
+    else if (parent != NULL && ctx->last_parent == parent->id && rect_equal(ctx->last_rect, c->outer))
+        info->id = id_hash(GuiLayoutIdLastCtx(ctx), 5, (unsigned int)ctx->last_nested++);
+    else
+        info->id = id_hash(parent_id, 2, (unsigned int)index);
+    ctx->next_key = 0;
+    info->nested = 0;
+    info->serial = -1;
+    info->item_base = 0;
+    info->spans = NULL;
+}
+
+// Remember which container and slot produced the last rect (hashed by GuiLayoutIdLast)
+// NOTE: info is the open container's cold data, slot counts from its item_base
+static void set_last_id(RGLContext *ctx, const RGLContainerInfo *info, int slot)
+{
+    ctx->last_parent = (info != NULL) ? info->id : 0;
+    ctx->last_keyed = (ctx->next_key != 0);
+    ctx->last_slot = ctx->last_keyed ? ctx->next_key : (unsigned int)((info != NULL) ? info->item_base + slot : slot);
+    ctx->last_nested = 0;
+    ctx->next_key = 0;
+}
+
+RGLAYOUTAPI unsigned int GuiLayoutIdLastCtx(RGLContext *ctx)
+{
+    if (ctx->last_parent == 0)
+        return 0;
+    return id_hash(ctx->last_parent, ctx->last_keyed ? 3 : 1, ctx->last_slot);
+}
+
+RGLAYOUTAPI unsigned int GuiLayoutIdCurrentCtx(RGLContext *ctx)
+{
+    const RGLState *st = &ctx->state;
+    return (st->top > 0 && st->overflow_depth == 0) ? st->info[st->top - 1].id : 0;
+}
+
+RGLAYOUTAPI void GuiLayoutSetNextKeyCtx(RGLContext *ctx, unsigned int key)
+{
+    ctx->next_key = key;
+}
+
+// ===== HIT-TEST INDEX =====
+
+RGLAYOUTAPI void RGLHitIndexInit(RGLHitIndex *index, RGLHitEntry *entries, int *children, int capacity)
+{
+    index->entries = entries;
+    index->children = children;
+    index->capacity = (entries != NULL && children != NULL && capacity > 0) ? capacity : 0;
+    RGLHitIndexReset(index);
+}
+
+RGLAYOUTAPI void RGLHitIndexReset(RGLHitIndex *index)
+{
+    if (index == NULL)
+        return;
+
+    index->count = 0;
+    index->roots = 0;
+    index->current = -1;
+    index->skip_depth = 0;
+    index->overflow = false;
+    index->built = false;
+}
+
+// Append an entry under the open container
+static int hit_push(RGLHitIndex *index, Rectangle rect, unsigned int tag)
+{
+    if (index->count >= index->capacity)
+    {
+        index->overflow = true;
+        return -1;
+    }
+
+    int id = index->count++;
+    RGLHitEntry *e = &index->entries[id];
+    e->rect = rect;
+    e->tag = tag;
+    e->parent = index->current;
+    e->depth = (index->current >= 0) ? index->entries[index->current].depth + 1 : 0;
+    e->first_child = 0;
+    e->child_count = 0;
+    e->axis = RGL_AXIS_ROW;
+    e->container = false;
+    e->row_major = false;
+    e->sorted = false;
+    index->built = false;
+    return id;
+}
+
+// Record a widget rect produced by the current container
+static void hit_rect(RGLHitIndex *index, Rectangle rect, unsigned int tag)
+{
+    if (index->skip_depth == 0)
+        hit_push(index, rect, tag);
+}
+
+// Record a pushed container and make it the parent of following entries
+// NOTE: GuiBeginRow(GuiLayoutRec(...)) would record the same rect twice, the widget entry becomes the container
+static void hit_begin(RGLHitIndex *index, const RGLContainer *c, unsigned int tag)
+{
+    if (index->skip_depth > 0)
+    {
+        index->skip_depth++;
+        return;
+    }
+
+    int id = -1;
+    if (index->count > 0)
+    {
+        RGLHitEntry *last = &index->entries[index->count - 1];
+        if (!last->container && last->parent == index->current && rect_equal(last->rect, c->outer))
+        {
+            id = index->count - 1;
+            if (tag != 0)
+                last->tag = tag;
+        }
+    }
+    if (id < 0)
+        id = hit_push(index, c->outer, tag);
+    if (id < 0)
+    {
+        index->skip_depth++;
+        return;
+    }
+
+    RGLHitEntry *e = &index->entries[id];
+    e->container = true;
+    e->axis = c->axis;
+    e->row_major = (c->columns != 0);
+    index->current = id;
+}
+
+// Close the open container
+static void hit_end(RGLHitIndex *index)
+{
+    if (index->skip_depth > 0)
+        index->skip_depth--;
+    else if (index->current >= 0)
+        index->current = index->entries[index->current].parent;
+}
+
+// Child lists can be binary searched when siblings don't overlap along the search keys:
+// rows/columns by main axis start, grids/flows by line (y) and then x within the line
+static bool hit_check_sorted(const RGLHitIndex *index, const RGLHitEntry *parent)
+{
+    const int *list = &index->children[parent->first_child];
+    bool row = (parent->axis == RGL_AXIS_ROW);
+    float lines_bottom = 0;
+
+    for (int i = 1; i < parent->child_count; i++)
+    {
+        Rectangle prev = index->entries[list[i - 1]].rect;
+        Rectangle cur = index->entries[list[i]].rect;
+
+        if (!parent->row_major)
+        {
+            if (row ? (prev.x + prev.width > cur.x) : (prev.y + prev.height > cur.y))
+                return false;
+            continue;
+        }
+
+        if (i == 1 || prev.y + prev.height > lines_bottom)
+            lines_bottom = prev.y + prev.height;
+        if (cur.y == prev.y)
+        {
+            if (prev.x + prev.width > cur.x)
+                return false;
+        }
+        else if (cur.y < prev.y || lines_bottom > cur.y)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+RGLAYOUTAPI void RGLHitIndexBuild(RGLHitIndex *index)
+{
+    if (index == NULL || index->built)
+        return;
+
+    RGLHitEntry *entries = index->entries;
+
+    // Count children, then give every container a contiguous slot range (roots first)
+    index->roots = 0;
+    for (int i = 0; i < index->count; i++)
+    {
+        entries[i].child_count = 0;
+        if (entries[i].parent >= 0)
+            entries[entries[i].parent].child_count++;
+        else
+            index->roots++;
+    }
+
+    int slot = index->roots;
+    for (int i = 0; i < index->count; i++)
+    {
+        entries[i].first_child = slot;
+        slot += entries[i].child_count;
+        entries[i].child_count = 0; // Refilled below
+    }
+
+    // Preorder keeps each child list in emission order
+    int roots = 0;
+    for (int i = 0; i < index->count; i++)
+    {
+        int p = entries[i].parent;
+        if (p < 0)
+            index->children[roots++] = i;
+        else
+            index->children[entries[p].first_child + entries[p].child_count++] = i;
+    }
+
+    for (int i = 0; i < index->count; i++)
+    {
+        entries[i].sorted = entries[i].container && hit_check_sorted(index, &entries[i]);
+    }
+
+    index->built = true;
+}
+
+static bool hit_contains(Rectangle r, float x, float y)
+{
+    return (x >= r.x) && (x < r.x + r.width) && (y >= r.y) && (y < r.y + r.height);
+}
+
+// First child in list[lo, hi) whose key (x or y) is past value (inclusive: key > value, else key >= value)
+static int hit_bound(const RGLHitIndex *index, const int *list, int lo, int hi, bool use_x, float value, bool inclusive)
+{
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        Rectangle r = index->entries[list[mid]].rect;
+        float key = use_x ? r.x : r.y;
+        if (inclusive ? (key <= value) : (key < value))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Child of 'parent' (NULL: roots) containing the point, the latest one wins on overlap
+static int hit_child(const RGLHitIndex *index, const RGLHitEntry *parent, float x, float y)
+{
+    const int *list = (parent != NULL) ? &index->children[parent->first_child] : index->children;
+    int count = (parent != NULL) ? parent->child_count : index->roots;
+
+    if (parent != NULL && parent->sorted)
+    {
+        int end;
+        if (!parent->row_major)
+        {
+            // Last child starting at or before the point along the main axis
+            bool row = (parent->axis == RGL_AXIS_ROW);
+            end = hit_bound(index, list, 0, count, row, row ? x : y, true);
+        }
+        else
+        {
+            // Line containing the point (last line starting above it), then x within that line
+            int line_end = hit_bound(index, list, 0, count, false, y, true);
+            if (line_end == 0)
+                return -1;
+            float line_y = index->entries[list[line_end - 1]].rect.y;
+            int line_start = hit_bound(index, list, 0, line_end, false, line_y, false);
+            end = hit_bound(index, list, line_start, line_end, true, x, true);
+            if (end == line_start)
+                return -1;
+        }
+
+        if (end > 0 && hit_contains(index->entries[list[end - 1]].rect, x, y))
+            return list[end - 1];
+        return -1;
+    }
+
+    for (int i = count - 1; i >= 0; i--)
+    {
+        if (hit_contains(index->entries[list[i]].rect, x, y))
+            return list[i];
+    }
+    return -1;
+}
+
+RGLAYOUTAPI int RGLHitTest(const RGLHitIndex *index, float x, float y)
+{
+    if (index == NULL || !index->built)
+        return -1;
+
+    int hit = -1;
+    int child = hit_child(index, NULL, x, y);
+    while (child >= 0)
+    {
+        hit = child;
+        child = (index->entries[hit].child_count > 0) ? hit_child(index, &index->entries[hit], x, y) : -1;
+    }
+    return hit;
+}
+
+RGLAYOUTAPI unsigned int RGLHitTestTag(const RGLHitIndex *index, float x, float y)
+{
+    for (int e = RGLHitTest(index, x, y); e >= 0; e = index->entries[e].parent)
+    {
+        if (index->entries[e].tag != 0)
+            return index->entries[e].tag;
+    }
+    return 0;
+}
+
+RGLAYOUTAPI void RGLSetHitIndexCtx(RGLContext *ctx, RGLHitIndex *index)
+{
+    ctx->hit = index;
+}
+
+RGLAYOUTAPI void GuiLayoutSetNextTagCtx(RGLContext *ctx, unsigned int tag)
+{
+    ctx->next_tag = tag;
+}
+
+// ===== COMMAND BUFFER =====
+
+RGLAYOUTAPI void RGLCommandBufferInit(RGLCommandBuffer *buffer, RGLCommand *commands, int capacity)
+{
+    buffer->commands = commands;
+    buffer->capacity = (commands != NULL && capacity > 0) ? capacity : 0;
+    RGLCommandBufferReset(buffer);
+}
+
+RGLAYOUTAPI void RGLCommandBufferReset(RGLCommandBuffer *buffer)
+{
+    if (buffer == NULL)
+        return;
+
+    buffer->count = 0;
+    buffer->containers = 0;
+    buffer->overflow = false;
+}
+
+RGLAYOUTAPI void RGLSetCommandBufferCtx(RGLContext *ctx, RGLCommandBuffer *buffer)
+{
+    ctx->commands = buffer;
+}
+
+// Append the command of a rect produced by the top container
+static void command_push(RGLCommandBuffer *buffer, const RGLState *st, Rectangle rect, unsigned int tag)
+{
+    if (buffer->count >= buffer->capacity)
+    {
+        buffer->overflow = true;
+        return;
+    }
+
+    RGLCommand *cmd = &buffer->commands[buffer->count++];
+    cmd->rect = rect;
+    cmd->tag = tag;
+    cmd->depth = st->top;
+    cmd->container = (st->top > 0) ? st->info[st->top - 1].serial : -1;
+}
+
+// ===== DAMAGE TRACKING =====
+
+RGLAYOUTAPI void RGLDamageInit(RGLDamage *damage, RGLDamageEntry *entries, int capacity)
+{
+    if (entries == NULL || capacity <= 0)
+        capacity = 0;
+
+    damage->current = entries;
+    damage->previous = entries + capacity;
+    damage->scratch = entries + 2*capacity;
+    damage->capacity = capacity;
+    damage->previous_count = 0;
+    damage->valid = false;
+    RGLDamageReset(damage);
+}
+
+RGLAYOUTAPI void RGLDamageInvalidate(RGLDamage *damage)
+{
+    damage->valid = false;
+}
+
+RGLAYOUTAPI void RGLDamageReset(RGLDamage *damage)
+{
+    if (damage == NULL)
+        return;
+
+    damage->count = 0;
+    damage->dirty_count = 0;
+    damage->full = false;
+    damage->overflow = false;
+}
+
+static float rect_area(Rectangle r)
+{
+    return r.width*r.height;
+}
+
+static Rectangle rect_union(Rectangle a, Rectangle b)
+{
+    float x0 = (a.x < b.x) ? a.x : b.x;
+    float y0 = (a.y < b.y) ? a.y : b.y;
+    float x1 = (a.x + a.width > b.x + b.width) ? a.x + a.width : b.x + b.width;
+    float y1 = (a.y + a.height > b.y + b.height) ? a.y + a.height : b.y + b.height;
+    return (Rectangle){x0, y0, x1 - x0, y1 - y0};
+}
+
+// Add a damaged area, coalescing it with the dirty set
+// NOTE: Rects merge when their bounding box is no larger than both areas together (overlapping,
+// nested or adjacent), a full set merges into the rect whose bounding box grows the least
+static void damage_add(RGLDamage *damage, Rectangle r)
+{
+    if (r.width <= 0 || r.height <= 0)
+        return;
+
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (int i = 0; i < damage->dirty_count; i++)
+        {
+            Rectangle u = rect_union(damage->dirty[i], r);
+            if (rect_area(u) <= rect_area(damage->dirty[i]) + rect_area(r))
+            {
+                r = u;
+                damage->dirty[i] = damage->dirty[--damage->dirty_count];
+                merged = true;
+                break;
+            }
+        }
+
+        if (!merged && damage->dirty_count == RGL_DAMAGE_RECTS)
+        {
+            int best = 0;
+            float best_waste = 0.0f;
+            for (int i = 0; i < damage->dirty_count; i++)
+            {
+                float waste = rect_area(rect_union(damage->dirty[i], r)) - rect_area(damage->dirty[i]) - rect_area(r);
+                if (i == 0 || waste < best_waste)
+                {
+                    best = i;
+                    best_waste = waste;
+                }
+            }
+            r = rect_union(damage->dirty[best], r);
+            damage->dirty[best] = damage->dirty[--damage->dirty_count];
+            merged = true;
+        }
+    }
+    damage->dirty[damage->dirty_count++] = r;
+}
+
+RGLAYOUTAPI void RGLDamageAddRect(RGLDamage *damage, Rectangle rect)
+{
+    damage_add(damage, rect);
+}
+
+// Record a produced rect
+static void damage_push(RGLDamage *damage, Rectangle rect, unsigned int key)
+{
+    if (key == 0)
+        return;
+    if (damage->count >= damage->capacity)
+    {
+        damage->overflow = true;
+        return;
+    }
+
+    damage->current[damage->count++] = (RGLDamageEntry){rect, key};
+}
+
+// Stable LSD radix sort by key (4 passes of 8 bits, result ends in 'entries')
+static void damage_sort(RGLDamageEntry *entries, RGLDamageEntry *scratch, int count)
+{
+    RGLDamageEntry *src = entries;
+    RGLDamageEntry *dst = scratch;
+
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        int offsets[256] = {0};
+        for (int i = 0; i < count; i++)
+            offsets[(src[i].key >> shift) & 0xff]++;
+
+        int sum = 0;
+        for (int b = 0; b < 256; b++)
+        {
+            int n = offsets[b];
+            offsets[b] = sum;
+            sum += n;
+        }
+
+        for (int i = 0; i < count; i++)
+            dst[offsets[(src[i].key >> shift) & 0xff]++] = src[i];
+
+        RGLDamageEntry *t = src;
+        src = dst;
+        dst = t;
+    }
+}
+
+RGLAYOUTAPI int RGLDamageBuild(RGLDamage *damage)
+{
+    damage_sort(damage->current, damage->scratch, damage->count);
+
+    // Without a reliable previous frame (or with a truncated current one) nothing can be ruled out
+    if (!damage->valid || damage->overflow)
+    {
+        damage->full = true;
+        damage->dirty_count = 0;
+    }
+    else
+    {
+        // Merge walk over both sorted frames, equal keys pair up in emission order
+        const RGLDamageEntry *prev = damage->previous;
+        const RGLDamageEntry *cur = damage->current;
+        int i = 0, j = 0;
+        while (i < damage->previous_count || j < damage->count)
+        {
+            if (j >= damage->count || (i < damage->previous_count && prev[i].key < cur[j].key))
+            {
+                damage_add(damage, prev[i++].rect); // Disappeared
+            }
+            else if (i >= damage->previous_count || cur[j].key < prev[i].key)
+            {
+                damage_add(damage, cur[j++].rect);  // Appeared
+            }
+            else
+            {
+                if (!rect_equal(prev[i].rect, cur[j].rect))
+                {
+                    damage_add(damage, prev[i].rect); // Moved or resized
+                    damage_add(damage, cur[j].rect);
+                }
+                i++;
+                j++;
+            }
+        }
+    }
+
+    // This frame becomes the reference for the next one
+    RGLDamageEntry *t = damage->previous;
+    damage->previous = damage->current;
+    damage->previous_count = damage->count;
+    damage->current = t;
+    damage->count = 0;
+    damage->valid = true;
+
+    return damage->dirty_count;
+}
+
+RGLAYOUTAPI void RGLSetDamageCtx(RGLContext *ctx, RGLDamage *damage)
+{
+    ctx->damage = damage;
+}
+
+RGLAYOUTAPI void GuiLayoutMarkDirtyCtx(RGLContext *ctx)
+{
+    if (ctx->damage != NULL)
+        damage_add(ctx->damage, ctx->last_rect);
+}
+
+// ===== OUTPUT RECORDING =====
+
+// Record a produced rect into the enabled outputs, consuming the pending tag
+static void record_rect(RGLContext *ctx, Rectangle rect)
+{
+    if (ctx->damage != NULL)
+        damage_push(ctx->damage, rect, (ctx->next_tag != 0) ? ctx->next_tag : GuiLayoutIdLastCtx(ctx));
+    if (ctx->commands != NULL)
+        command_push(ctx->commands, &ctx->state, rect, ctx->next_tag);
+    if (ctx->hit != NULL)
+        hit_rect(ctx->hit, rect, ctx->next_tag);
+    ctx->next_tag = 0;
+}
+
+// Record a container pushed on the stack (c is the new top)
+static void record_begin(RGLContext *ctx, RGLContainer *c)
+{
+    if (ctx->commands != NULL)
+        ctx->state.info[c - ctx->state.stack].serial = ctx->commands->containers++;
+    if (ctx->hit != NULL)
+        hit_begin(ctx->hit, c, ctx->next_tag);
+    ctx->next_tag = 0;
+}
+
+// ===== ZONE TRACING =====
+
+// Ring head accesses: release store by the producer, acquire load by the exporter.
+// RGL_TRACE_FENCE() keeps the exporter's copy of an event before its re-check of the head
+#if defined(__GNUC__) || defined(__clang__)
+    #define RGL_TRACE_PUBLISH(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define RGL_TRACE_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define RGL_TRACE_FENCE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+    // NOTE: MSVC volatile accesses have acquire/release semantics on x86/x64 (/volatile:ms),
+    // where loads are not reordered with loads, so a compiler barrier is enough
+    #define RGL_TRACE_PUBLISH(p, v) (*(volatile unsigned int *)(p) = (v))
+    #define RGL_TRACE_ACQUIRE(p) (*(volatile unsigned int *)(p))
+    #define RGL_TRACE_FENCE() _ReadWriteBarrier()
+#endif
+
+RGLAYOUTAPI void RGLTraceInit(RGLTraceBuffer *buffer, RGLTraceEvent *events, int capacity, int thread_id)
+{
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->thread_id = thread_id;
+    if (events == NULL || capacity <= 0)
+        return;
+
+    unsigned int size = 1;
+    while (size <= (unsigned int)capacity / 2)
+        size *= 2;
+    buffer->events = events;
+    buffer->capacity = size;
+}
+
+RGLAYOUTAPI void RGLSetTraceCtx(RGLContext *ctx, RGLTraceBuffer *buffer)
+{
+    ctx->trace = buffer;
+    if (buffer != NULL)
+        buffer->open = 0;
+}
+
+RGLAYOUTAPI void GuiLayoutSetNextZoneCtx(RGLContext *ctx, const char *name)
+{
+    ctx->next_zone = name;
+}
+
+#if defined(RGLAYOUT_ENABLE_TRACE)
+#if !defined(RGL_TRACE_CLOCK)
+// Nanosecond timestamp: POSIX monotonic clock, C11 wall clock, or processor time as a last resort
+static unsigned long long trace_clock(void)
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+#elif defined(TIME_UTC)
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+#else
+    return (unsigned long long)((double)clock() * (1000000000.0 / CLOCKS_PER_SEC));
+#endif
+}
+#define RGL_TRACE_CLOCK() trace_clock()
+#endif
+
+// Zone name of a container without a user name
+static const char *trace_kind(const RGLContainer *c)
+{
+    if (c->columns == RGL_FLOW)
+        return "Flow";
+    if (c->columns > 0)
+        return "Grid";
+    return (c->axis == RGL_AXIS_ROW) ? "Row" : "Column";
+}
+
+// Open a zone for the container just pushed (c is the new top)
+static void trace_begin(RGLContext *ctx, const RGLContainer *c)
+{
+    RGLTraceBuffer *trace = ctx->trace;
+    if (trace->open < RGL_TRACE_DEPTH)
+    {
+        RGLTraceEvent *zone = &trace->zones[trace->open];
+        zone->name = (ctx->next_zone != NULL) ? ctx->next_zone : trace_kind(c);
+        zone->id = ctx->state.info[ctx->state.top - 1].id;
+        zone->depth = ctx->state.top;
+        zone->start = (unsigned long long)RGL_TRACE_CLOCK();
+    }
+    trace->open++;
+    ctx->next_zone = NULL;
+}
+
+// Close the innermost zone and publish it to the ring
+static void trace_end(RGLContext *ctx)
+{
+    RGLTraceBuffer *trace = ctx->trace;
+    if (trace->open == 0)
+        return; // Buffer was installed inside this container
+
+    trace->open--;
+    if (trace->open >= RGL_TRACE_DEPTH || trace->capacity == 0)
+        return;
+
+    RGLTraceEvent zone = trace->zones[trace->open];
+    zone.duration = (unsigned long long)RGL_TRACE_CLOCK() - zone.start;
+
+    unsigned int head = trace->head;
+    trace->events[head & (trace->capacity - 1)] = zone;
+    RGL_TRACE_PUBLISH(&trace->head, head + 1);
+}
+
+// Write a JSON string, escaping quotes, backslashes and control characters
+static void trace_write_string(FILE *file, const char *text)
+{
+    fputc('"', file);
+    for (const unsigned char *p = (const unsigned char *)text; *p != '\0'; p++)
+    {
+        if (*p == '"' || *p == '\\')
+            fprintf(file, "\\%c", *p);
+        else if (*p < 0x20)
+            fprintf(file, "\\u%04x", *p);
+        else
+            fputc(*p, file);
+    }
+    fputc('"', file);
+}
+#endif
+
+// NOTE: Timestamps are relative to the earliest exported zone. A zone is re-validated after it is
+// copied, zones the producer overwrote meanwhile are counted as dropped instead of written torn.
+// The producer fills slot head before publishing head + 1, so the zone capacity events behind the
+// head may be half-written: only the newest capacity - 1 zones are exported
+RGLAYOUTAPI bool RGLTraceExport(RGLTraceBuffer *const *buffers, int count, const char *fileName)
+{
+#if defined(RGLAYOUT_ENABLE_TRACE)
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL)
+        return false;
+
+    // Snapshot the heads once, zones written while exporting go to the next export
+    unsigned long long base = 0;
+    bool have_base = false;
+    for (int b = 0; b < count; b++)
+    {
+        RGLTraceBuffer *trace = buffers[b];
+        if (trace == NULL || trace->capacity == 0)
+            continue;
+        unsigned int head = RGL_TRACE_ACQUIRE(&trace->head);
+        if (head - trace->tail >= trace->capacity)
+        {
+            trace->dropped += head - trace->tail - (trace->capacity - 1);
+            trace->tail = head - (trace->capacity - 1);
+        }
+        for (unsigned int i = trace->tail; i != head; i++)
+        {
+            unsigned long long start = trace->events[i & (trace->capacity - 1)].start;
+            if (!have_base || start < base)
+                base = start;
+            have_base = true;
+        }
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    bool first = true;
+    for (int b = 0; b < count; b++)
+    {
+        RGLTraceBuffer *trace = buffers[b];
+        if (trace == NULL || trace->capacity == 0)
+            continue;
+
+        unsigned int head = RGL_TRACE_ACQUIRE(&trace->head);
+        for (unsigned int i = trace->tail; i != head; i++)
+        {
+            RGLTraceEvent zone = trace->events[i & (trace->capacity - 1)];
+            RGL_TRACE_FENCE();
+            if (RGL_TRACE_ACQUIRE(&trace->head) - i >= trace->capacity)
+            {
+                trace->dropped++;
+                continue;
+            }
+            if (zone.start < base)
+                zone.start = base; // Overwritten after the base pass
+
+            fprintf(file, "%s\n{\"name\":", first ? "" : ",");
+            trace_write_string(file, (zone.name != NULL) ? zone.name : "");
+            fprintf(file, ",\"cat\":\"layout\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+                    "\"args\":{\"id\":\"0x%08x\",\"depth\":%d}}",
+                    (double)(zone.start - base) / 1000.0, (double)zone.duration / 1000.0,
+                    trace->thread_id, zone.id, zone.depth);
+            first = false;
+        }
+        trace->tail = head;
+    }
+    fprintf(file, "\n]}\n");
+
+    return (fclose(file) == 0);
+#else
+    (void)buffers;
+    (void)count;
+    (void)fileName;
+    return false;
+#endif
+}
+
+// ===== STACK STORAGE =====
+
+// Move a stack-ordered buffer into a larger block, keeping its first 'used' elements
+// NOTE: Allocator hooks take precedence over the arena, arena blocks are never freed individually
+static void *grow_buffer(RGLContext *ctx, void *buffer, bool *heap, int used, int capacity, size_t elem)
+{
+    void *block = NULL;
+
+    if (ctx->alloc_fn != NULL)
+    {
+        block = ctx->alloc_fn(*heap ? buffer : NULL, (size_t)capacity * elem, ctx->alloc_user);
+        if (block != NULL && !*heap)
+            memcpy(block, buffer, (size_t)used * elem);
+        if (block != NULL)
+            *heap = true;
+    }
+    else if (ctx->arena != NULL && !*heap)
+    {
+        block = RGLArenaAlloc(ctx->arena, (size_t)capacity * elem);
+        if (block != NULL)
+            memcpy(block, buffer, (size_t)used * elem);
+    }
+
+    return block;
+}
+
+// Next capacity for a doubling buffer (0: would overflow int)
+static int grow_capacity(int capacity, int needed)
+{
+    while (capacity < needed)
+    {
+        if (capacity > 0x3fffffff)
+            return 0;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+// Make room for one more container (slow path of begin_container)
+static bool reserve_stack(RGLContext *ctx)
+{
+    RGLState *st = &ctx->state;
+
+    // First push into a zeroed (or unloaded) context: start in the inline buffers
+    if (st->stack == NULL)
+    {
+        st->stack = st->inline_stack;
+        st->info = st->inline_info;
+        st->stack_capacity = RGL_MAX_STACK;
+        st->spans = st->inline_spans;
+        st->span_capacity = RGL_SPAN_MAX;
+    }
+    if (st->top < st->stack_capacity)
+        return true;
+
+    // Info grows first: a larger info block is harmless if the stack can't follow
+    int capacity = grow_capacity(st->stack_capacity, st->top + 1);
+    RGLContainerInfo *info = (capacity > 0) ? (RGLContainerInfo *)grow_buffer(ctx, st->info, &st->info_heap, st->top, capacity, sizeof(RGLContainerInfo)) : NULL;
+    if (info == NULL)
+        return false;
+    st->info = info;
+
+    RGLContainer *block = (RGLContainer *)grow_buffer(ctx, st->stack, &st->stack_heap, st->top, capacity, sizeof(RGLContainer));
+    if (block == NULL)
+        return false;
+
+    st->stack = block;
+    st->stack_capacity = capacity;
+    return true;
+}
+
+// Make room for 'count' more spans (slow path, storage is already set up by reserve_stack)
+static bool reserve_spans(RGLContext *ctx, int count)
+{
+    RGLState *st = &ctx->state;
+    if (count <= st->span_capacity - st->span_top)
+        return true;
+
+    int capacity = grow_capacity(st->span_capacity, st->span_top + count);
+    RGLSpan *block = (capacity > 0) ? (RGLSpan *)grow_buffer(ctx, st->spans, &st->spans_heap, st->span_top, capacity, sizeof(RGLSpan)) : NULL;
+    if (block == NULL)
+        return false;
+
+    st->spans = block;
+    st->span_capacity = capacity;
+    return true;
+}
+
+// Skip a container that could not be pushed; End pops it, Rec inside it returns zero rects
+static void skip_container(RGLContext *ctx, int error)
+{
+    RGL_STAT_ADD(ctx, overflows, 1);
+    ctx->next_key = 0;
+    ctx->next_zone = NULL;
+    ctx->state.overflow_depth++;
+    ctx->errors |= error;
+}
+
+// ===== PUBLIC API =====
+
+// Push a container onto the context stack
+static void begin_container(RGLContext *ctx, Rectangle bounds, RGLAxis axis, RGLPad pad, float gap, const RGLPlan *plan)
+{
+    RGL_STAT_CLOCK(t0);
+    RGLPlan scratch;
+    plan = plan_checked(plan, &scratch);
+    RGL_RECORD(ctx, log_begin(ctx->recorder, axis, bounds, pad, gap, plan));
+    RGLState *st = &ctx->state;
+    unsigned int id = ctx->next_id;
+    ctx->next_id = 0;
+
+    // Children of a skipped container are skipped too, their bounds are meaningless
+    if (st->overflow_depth > 0 || (st->top >= st->stack_capacity && !reserve_stack(ctx)))
+    {
+        skip_container(ctx, RGL_ERROR_STACK_OVERFLOW);
+        return;
+    }
+
+    // Build the container in place, no temporaries or plan copies
+    RGLContainer *c = &st->stack[st->top];
+    init_common(c, bounds, axis, pad, gap, plan);
+
+    // Resolve the whole plan now, every planned GuiLayoutRec is then a lookup
+    // NOTE: Cached containers read their entry in place and take no span stack room
+    const RGLSpan *cached = NULL;
+    if (ctx->cache != NULL && id != 0 && c->plan_length > 0 && c->plan_length <= RGL_PLAN_MAX)
+        cached = resolve_plan_cached(ctx->cache, st, id, c, plan);
+
+    if (cached == NULL && c->plan_length > st->span_capacity - st->span_top && !reserve_spans(ctx, c->plan_length))
+    {
+        skip_container(ctx, RGL_ERROR_SPAN_OVERFLOW);
+        return;
+    }
+
+    // Only a container that is pushed takes a sibling index, so skips never shift later IDs
+    init_id(ctx, c);
+    if (cached != NULL)
+    {
+        c->span_base = -1;
+        st->info[st->top].spans = cached;
+    }
+    else
+    {
+        c->span_base = st->span_top;
+        resolve_plan(c, plan, &st->spans[c->span_base]);
+        st->span_top += c->plan_length;
+    }
+
+    st->top++;
+    RGL_STAT_ADD(ctx, containers, 1);
+    RGL_STAT_MAX(ctx, max_depth, st->top);
+    if (ctx->hit != NULL || ctx->commands != NULL)
+        record_begin(ctx, c);
+    RGL_TRACE_BEGIN(ctx, c);
+    RGL_STAT_CYCLES(ctx, begin_cycles, t0);
+}
+
+// Start offset of a scroll item in content space (gaps included)
+static double scroll_item_offset(int i, float item_size, float gap, const RGLScrollIndex *index)
+{
+    if (index != NULL)
+        return index->prefix[i] + (double)i * gap;
+    return (double)i * ((double)item_size + gap);
+}
+
+// Size of a scroll item along the main axis
+static float scroll_item_size(int i, float item_size, const RGLScrollIndex *index)
+{
+    if (index != NULL)
+        return (float)(index->prefix[i + 1] - index->prefix[i]);
+    return item_size;
+}
+
+// Push a virtualized scroll container, resolving spans for the visible items only
+// NOTE: Uniform items are placed in O(1), variable items use a binary search over the prefix sums
+static RGLRange begin_scroll(RGLContext *ctx, Rectangle bounds, RGLAxis axis, RGLPad pad, float gap, float scroll,
+                             int count, float item_size, const RGLScrollIndex *index)
+{
+    RGL_STAT_CLOCK(t0);
+    RGL_RECORD(ctx, log_scroll(ctx->recorder, axis, bounds, pad, gap, scroll, count, item_size, index));
+    RGLRange range = {0, 0};
+    RGLState *st = &ctx->state;
+    ctx->next_id = 0; // Scroll containers are not cached, visible spans change with the offset
+    if (st->overflow_depth > 0 || (st->top >= st->stack_capacity && !reserve_stack(ctx)))
+    {
+        skip_container(ctx, RGL_ERROR_STACK_OVERFLOW);
+        return range;
+    }
+
+    RGLContainer *c = &st->stack[st->top];
+    init_common(c, bounds, axis, pad, gap, NULL);
+    init_id(ctx, c);
+    c->span_base = st->span_top;
+    st->top++;
+    RGL_STAT_ADD(ctx, containers, 1);
+    RGL_STAT_MAX(ctx, max_depth, st->top);
+    if (ctx->hit != NULL || ctx->commands != NULL)
+        record_begin(ctx, c);
+    RGL_TRACE_BEGIN(ctx, c);
+
+    if (index != NULL && index->count < count)
+        count = index->count;
+    if (count <= 0)
+        return range;
+
+    double view_start = scroll;
+    double view_end = view_start + c->remaining;
+    int first = 0;
+    int end = 0;
+
+    if (index == NULL)
+    {
+        if (item_size < 0)
+            item_size = 0;
+        double stride = (double)item_size + gap;
+        if (stride <= 0)
+            return range;
+
+        // First item whose end is past the scroll offset
+        double f = view_start / stride;
+        first = (f <= 0) ? 0 : (f >= count) ? count : (int)f;
+        if (first < count && scroll_item_offset(first, item_size, gap, NULL) + item_size <= view_start)
+            first++;
+
+        // First item starting at or past the viewport end
+        double e = view_end / stride;
+        end = (e <= 0) ? 0 : (e >= count) ? count : (int)e;
+        if (end < count && scroll_item_offset(end, item_size, gap, NULL) < view_end)
+            end++;
+    }
+    else
+    {
+        // Binary search the first item whose end is past the scroll offset
+        int lo = 0;
+        int hi = count;
+        while (lo < hi)
+        {
+            int mid = lo + (hi - lo) / 2;
+            if (index->prefix[mid + 1] + (double)mid * gap > view_start)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        first = lo;
+
+        // Binary search the first item starting at or past the viewport end
+        hi = count;
+        while (lo < hi)
+        {
+            int mid = lo + (hi - lo) / 2;
+            if (index->prefix[mid] + (double)mid * gap >= view_end)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        end = lo;
+    }
+
+    if (first > count)
+        first = count;
+    if (end > count)
+        end = count;
+    if (end < first)
+        end = first;
+    st->info[st->top - 1].item_base = first; // Item IDs follow the data item, not the visible slot
+
+    // Span storage is shared with plans, truncate the range (and report it) if it cannot grow
+    if (end - first > st->span_capacity - st->span_top && !reserve_spans(ctx, end - first))
+    {
+        end = first + (st->span_capacity - st->span_top);
+        ctx->errors |= RGL_ERROR_SPAN_OVERFLOW;
+    }
+
+    // Place visible items relative to the scrolled content origin
+    RGLSpan *spans = &st->spans[c->span_base];
+    double origin = (double)c->cursor - scroll;
+    for (int i = first; i < end; i++)
+    {
+        spans[i - first] = (RGLSpan){(float)(origin + scroll_item_offset(i, item_size, gap, index)), scroll_item_size(i, item_size, index)};
+    }
+
+    c->plan_length = end - first;
+    st->span_top += c->plan_length;
+
+    range.first = first;
+    range.count = end - first;
+    RGL_STAT_CYCLES(ctx, begin_cycles, t0);
+    return range;
+}
+
+RGLAYOUTAPI RGLRange GuiBeginScrollRowCtx(RGLContext *ctx, Rectangle bounds, float scroll, int count, float item_size)
+{
+    return begin_scroll(ctx, bounds, RGL_AXIS_ROW, ctx->default_pad, ctx->default_gap, scroll, count, item_size, NULL);
+}
+
+RGLAYOUTAPI RGLRange GuiBeginScrollRowExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, float scroll, int count, float item_size, const RGLScrollIndex *index)
+{
+    return begin_scroll(ctx, bounds, RGL_AXIS_ROW, pad, gap, scroll, count, item_size, index);
+}
+
+RGLAYOUTAPI RGLRange GuiBeginScrollColumnCtx(RGLContext *ctx, Rectangle bounds, float scroll, int count, float item_size)
+{
+    return begin_scroll(ctx, bounds, RGL_AXIS_COLUMN, ctx->default_pad, ctx->default_gap, scroll, count, item_size, NULL);
+}
+
+RGLAYOUTAPI RGLRange GuiBeginScrollColumnExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, float scroll, int count, float item_size, const RGLScrollIndex *index)
+{
+    return begin_scroll(ctx, bounds, RGL_AXIS_COLUMN, pad, gap, scroll, count, item_size, index);
+}
+
+RGLAYOUTAPI void GuiScrollIndexBuild(RGLScrollIndex *index, double *buffer, int count, RGLItemSizeFunc size_fn, void *user)
+{
+    if (index == NULL)
+        return;
+
+    index->prefix = buffer;
+    index->count = (buffer != NULL && count > 0) ? count : 0;
+    if (buffer != NULL)
+        buffer[0] = 0;
+
+    GuiScrollIndexUpdate(index, 0, size_fn, user);
+}
+
+RGLAYOUTAPI void GuiScrollIndexUpdate(RGLScrollIndex *index, int from, RGLItemSizeFunc size_fn, void *user)
+{
+    if (index == NULL || index->prefix == NULL || size_fn == NULL)
+        return;
+    if (from < 0)
+        from = 0;
+
+    for (int i = from; i < index->count; i++)
+    {
+        float size = size_fn(i, user);
+        index->prefix[i + 1] = index->prefix[i] + ((size > 0) ? size : 0);
+    }
+}
+
+RGLAYOUTAPI float GuiScrollContentSize(int count, float item_size, float gap, const RGLScrollIndex *index)
+{
+    if (index != NULL && index->count < count)
+        count = index->count;
+    if (count <= 0)
+        return 0;
+
+    double items = (index != NULL) ? index->prefix[count] : (double)count * item_size;
+    return (float)(items + (double)(count - 1) * gap);
+}
+
+// Rectangle covering grid cells [row, row + row_span) x [col, col + col_span), spans clamped to the grid
+// NOTE: Two track lookups, O(1) for any cell
+static Rectangle grid_cell(const RGLContainer *c, const RGLSpan *spans, int row, int col, int row_span, int col_span)
+{
+    int rows = c->plan_length / c->columns;
+    if (row < 0 || col < 0 || row >= rows || col >= c->columns || row_span < 1 || col_span < 1)
+        return (Rectangle){0, 0, 0, 0};
+    if (row_span > rows - row)
+        row_span = rows - row;
+    if (col_span > c->columns - col)
+        col_span = c->columns - col;
+
+    const RGLSpan *cols = &spans[c->span_base];
+    const RGLSpan *rows_tracks = &spans[c->span_base + c->columns];
+    RGLSpan x0 = cols[col];
+    RGLSpan x1 = cols[col + col_span - 1];
+    RGLSpan y0 = rows_tracks[row];
+    RGLSpan y1 = rows_tracks[row + row_span - 1];
+
+    return (Rectangle){
+        .x = x0.offset,
+        .y = y0.offset,
+        .width = x1.offset + x1.size - x0.offset,
+        .height = y1.offset + y1.size - y0.offset};
+}
+
+// Push a grid container, resolving column and row tracks once with the plan rules
+// NOTE: A NULL or empty plan is a single fill track, each plan's gap applies along its own axis
+static void begin_grid(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, const RGLPlan *col_plan, const RGLPlan *row_plan)
+{
+    RGL_STAT_CLOCK(t0);
+    RGLPlan col_scratch, row_scratch;
+    col_plan = plan_checked(col_plan, &col_scratch);
+    row_plan = plan_checked(row_plan, &row_scratch);
+    RGL_RECORD(ctx, log_grid(ctx->recorder, bounds, pad, gap, col_plan, row_plan));
+    RGLState *st = &ctx->state;
+    ctx->next_id = 0; // Grids are not cached
+
+    if (st->overflow_depth > 0 || (st->top >= st->stack_capacity && !reserve_stack(ctx)))
+    {
+        skip_container(ctx, RGL_ERROR_STACK_OVERFLOW);
+        return;
+    }
+
+    RGLPlan fill = GuiPlanCreate(NULL, 0);
+    if (col_plan == NULL || col_plan->length <= 0 || row_plan == NULL || row_plan->length <= 0)
+        GuiPlanAdd(&fill, -1);
+    if (col_plan == NULL || col_plan->length <= 0)
+        col_plan = &fill;
+    if (row_plan == NULL || row_plan->length <= 0)
+        row_plan = &fill;
+
+    // Columns resolve like a planned row, padding and column gap come from the column plan
+    RGLContainer *c = &st->stack[st->top];
+    init_common(c, bounds, RGL_AXIS_ROW, pad, gap, col_plan);
+
+    int tracks = col_plan->length + row_plan->length;
+    if (tracks > st->span_capacity - st->span_top && !reserve_spans(ctx, tracks))
+    {
+        skip_container(ctx, RGL_ERROR_SPAN_OVERFLOW);
+        return;
+    }
+    init_id(ctx, c);
+
+    c->span_base = st->span_top;
+    resolve_plan(c, col_plan, &st->spans[c->span_base]);
+
+    // Rows resolve like a planned column over the same inner rectangle
+    RGLContainer rows = *c;
+    rows.axis = RGL_AXIS_COLUMN;
+    rows.gap = row_plan->has_gap ? row_plan->gap : gap;
+    rows.cursor = c->inner.y;
+    rows.remaining = c->inner.height;
+    rows.plan_length = row_plan->length;
+    resolve_plan(&rows, row_plan, &st->spans[c->span_base + col_plan->length]);
+
+    c->columns = col_plan->length;
+    c->plan_length = col_plan->length * row_plan->length;
+    st->span_top += tracks;
+    st->top++;
+    RGL_STAT_ADD(ctx, containers, 1);
+    RGL_STAT_MAX(ctx, max_depth, st->top);
+    if (ctx->hit != NULL || ctx->commands != NULL)
+        record_begin(ctx, c);
+    RGL_TRACE_BEGIN(ctx, c);
+    RGL_STAT_CYCLES(ctx, begin_cycles, t0);
+}
+
+RGLAYOUTAPI void GuiBeginGridCtx(RGLContext *ctx, Rectangle bounds, const RGLPlan *col_plan, const RGLPlan *row_plan)
+{
+    begin_grid(ctx, bounds, ctx->default_pad, ctx->default_gap, col_plan, row_plan);
+}
+
+RGLAYOUTAPI void GuiBeginGridExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, const RGLPlan *col_plan, const RGLPlan *row_plan)
+{
+    begin_grid(ctx, bounds, pad, gap, col_plan, row_plan);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutCellCtx(RGLContext *ctx, int row, int col)
+{
+    return GuiLayoutCellSpanCtx(ctx, row, col, 1, 1);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutCellSpanCtx(RGLContext *ctx, int row, int col, int row_span, int col_span)
+{
+    RGLState *st = &ctx->state;
+    Rectangle result = {0, 0, 0, 0};
+
+    if (st->top > 0 && st->overflow_depth == 0 && st->stack[st->top - 1].columns > 0)
+    {
+        const RGLContainer *c = &st->stack[st->top - 1];
+        result = grid_cell(c, st->spans, row, col, row_span, col_span);
+        set_last_id(ctx, &st->info[st->top - 1], row*c->columns + col); // Same slot as the row-major GuiLayoutRec cell
+        RGL_STAT_ADD(ctx, planned, 1);
+        if (ctx->hit != NULL || ctx->commands != NULL || ctx->damage != NULL)
+            record_rect(ctx, result);
+    }
+    else
+    {
+        set_last_id(ctx, NULL, 0);
+    }
+
+    RGL_STAT_ADD(ctx, rects, 1);
+    RGL_STAT_ADD(ctx, zero_rects, (result.width <= 0 || result.height <= 0) ? 1 : 0);
+    RGL_RECORD(ctx, log_cell(ctx->recorder, row, col, row_span, col_span, result));
+    ctx->last_rect = result;
+    return result;
+}
+
+// Push a flow container: items run left to right and wrap onto a new line when they don't fit
+// NOTE: State lives in two spans: [0] current line (y, height), [1] widest line end and default item height
+static void begin_flow(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, float line_size)
+{
+    RGL_STAT_CLOCK(t0);
+    RGL_RECORD(ctx, log_flow(ctx->recorder, bounds, pad, gap, line_size));
+    RGLState *st = &ctx->state;
+    ctx->next_id = 0; // Flows are not cached
+
+    if (st->overflow_depth > 0 || (st->top >= st->stack_capacity && !reserve_stack(ctx)))
+    {
+        skip_container(ctx, RGL_ERROR_STACK_OVERFLOW);
+        return;
+    }
+    if (2 > st->span_capacity - st->span_top && !reserve_spans(ctx, 2))
+    {
+        skip_container(ctx, RGL_ERROR_SPAN_OVERFLOW);
+        return;
+    }
+
+    RGLContainer *c = &st->stack[st->top];
+    init_common(c, bounds, RGL_AXIS_ROW, pad, gap, NULL);
+    init_id(ctx, c);
+    c->columns = RGL_FLOW;
+    c->span_base = st->span_top;
+
+    st->spans[c->span_base] = (RGLSpan){c->inner.y, 0};
+    st->spans[c->span_base + 1] = (RGLSpan){0, (line_size > 0) ? line_size : 0};
+    st->span_top += 2;
+    st->top++;
+    RGL_STAT_ADD(ctx, containers, 1);
+    RGL_STAT_MAX(ctx, max_depth, st->top);
+    if (ctx->hit != NULL || ctx->commands != NULL)
+        record_begin(ctx, c);
+    RGL_TRACE_BEGIN(ctx, c);
+    RGL_STAT_CYCLES(ctx, begin_cycles, t0);
+}
+
+// Place the next flow item (amortized O(1): at most one line break per item)
+static Rectangle take_flow(RGLContainer *c, RGLContainerInfo *info, RGLSpan *state, float main, float cross)
+{
+    RGLSpan *line = &state[0];
+    RGLSpan *extent = &state[1];
+    float line_width = c->inner.width;
+
+    // Items wider than a line get a line of their own, -1 fills the rest of the line
+    float w = (main > line_width) ? line_width : main;
+    float h = (cross < 0) ? extent->size : cross;
+    float before = (c->placed > 0) ? c->gap : 0;
+
+    if (c->placed > 0 && ((main < 0) ? c->remaining - before <= 0 : before + w > c->remaining))
+    {
+        // Wrap: the new line starts below the tallest item of the current one
+        line->offset += line->size + c->gap;
+        line->size = 0;
+        c->cursor = c->inner.x;
+        c->remaining = line_width;
+        info->item_base += c->placed; // IDs keep counting across lines
+        c->placed = 0;
+        before = 0;
+    }
+
+    c->cursor += before;
+    c->remaining -= before;
+    if (main < 0)
+        w = c->remaining;
+    if (w < 0)
+        w = 0;
+
+    Rectangle r = {c->cursor, line->offset, w, h};
+    c->cursor += w;
+    c->remaining -= w;
+    c->placed++;
+
+    if (h > line->size)
+        line->size = h;
+    if (c->cursor - c->inner.x > extent->offset)
+        extent->offset = c->cursor - c->inner.x;
+    return r;
+}
+
+RGLAYOUTAPI void GuiBeginFlowCtx(RGLContext *ctx, Rectangle bounds, float line_size)
+{
+    begin_flow(ctx, bounds, ctx->default_pad, ctx->default_gap, line_size);
+}
+
+RGLAYOUTAPI void GuiBeginFlowExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, float line_size)
+{
+    begin_flow(ctx, bounds, pad, gap, line_size);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutContentSizeCtx(RGLContext *ctx)
+{
+    RGLState *st = &ctx->state;
+    if (st->top <= 0 || st->overflow_depth > 0)
+        return (Rectangle){0, 0, 0, 0};
+
+    const RGLContainer *c = &st->stack[st->top - 1];
+    float pad_w = c->outer.width - c->inner.width;
+    float pad_h = c->outer.height - c->inner.height;
+
+    if (c->columns == RGL_FLOW)
+    {
+        const RGLSpan *line = &st->spans[c->span_base];
+        const RGLSpan *extent = &st->spans[c->span_base + 1];
+        return (Rectangle){0, 0, extent->offset + pad_w, line->offset + line->size - c->inner.y + pad_h};
+    }
+    if (c->columns > 0)
+        return (Rectangle){0, 0, c->outer.width, c->outer.height};
+
+    // Rows and columns: children placed so far along the main axis, full cross axis
+    float used = c->cursor - (is_row(c) ? c->inner.x : c->inner.y);
+    if (is_row(c))
+        return (Rectangle){0, 0, used + pad_w, c->outer.height};
+    return (Rectangle){0, 0, c->outer.width, used + pad_h};
+}
+
+RGLAYOUTAPI void GuiBeginRowCtx(RGLContext *ctx, Rectangle bounds, const RGLPlan *plan)
+{
+    begin_container(ctx, bounds, RGL_AXIS_ROW, ctx->default_pad, ctx->default_gap, plan);
+}
+
+RGLAYOUTAPI void GuiBeginRowExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, const RGLPlan *plan)
+{
+    begin_container(ctx, bounds, RGL_AXIS_ROW, pad, gap, plan);
+}
+
+RGLAYOUTAPI void GuiBeginColumnCtx(RGLContext *ctx, Rectangle bounds, const RGLPlan *plan)
+{
+    begin_container(ctx, bounds, RGL_AXIS_COLUMN, ctx->default_pad, ctx->default_gap, plan);
+}
+
+RGLAYOUTAPI void GuiBeginColumnExCtx(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, const RGLPlan *plan)
+{
+    begin_container(ctx, bounds, RGL_AXIS_COLUMN, pad, gap, plan);
+}
+
+// Open a row or column with the plan its breakpoint table selects for the bounds width
+// NOTE: With a layout cache and an ID the selection is kept per container and only redone when the
+// width leaves the selected band, the plan's spans are then replayed by the regular cache lookup
+static void begin_responsive(RGLContext *ctx, Rectangle bounds, RGLAxis axis, const RGLBreakpoint *breakpoints, int count)
+{
+    if (breakpoints == NULL || count <= 0)
+    {
+        begin_container(ctx, bounds, axis, ctx->default_pad, ctx->default_gap, NULL);
+        return;
+    }
+
+    unsigned int id = ctx->next_id;
+    RGLCacheEntry *e = (ctx->cache != NULL && id != 0) ? cache_find(ctx->cache, id) : NULL;
+    if (e != NULL && e->breakpoints == breakpoints && e->breakpoint_count == count &&
+        bounds.width >= e->band_min && bounds.width < e->band_max)
+    {
+        begin_container(ctx, bounds, axis, ctx->default_pad, ctx->default_gap, breakpoints[e->breakpoint].plan);
+        return;
+    }
+
+    float band_min, band_max;
+    int selected = select_breakpoint(breakpoints, count, bounds.width, &band_min, &band_max);
+    begin_container(ctx, bounds, axis, ctx->default_pad, ctx->default_gap, breakpoints[selected].plan);
+
+    // Store the selection once the container has its cache entry (planned containers only)
+    e = (ctx->cache != NULL && id != 0) ? cache_find(ctx->cache, id) : NULL;
+    if (e != NULL)
+    {
+        e->breakpoints = breakpoints;
+        e->breakpoint_count = count;
+        e->breakpoint = selected;
+        e->band_min = band_min;
+        e->band_max = band_max;
+    }
+}
+
+RGLAYOUTAPI void GuiBeginRowResponsiveCtx(RGLContext *ctx, Rectangle bounds, const RGLBreakpoint *breakpoints, int count)
+{
+    begin_responsive(ctx, bounds, RGL_AXIS_ROW, breakpoints, count);
+}
+
+RGLAYOUTAPI void GuiBeginColumnResponsiveCtx(RGLContext *ctx, Rectangle bounds, const RGLBreakpoint *breakpoints, int count)
+{
+    begin_responsive(ctx, bounds, RGL_AXIS_COLUMN, breakpoints, count);
+}
+
+RGLAYOUTAPI void GuiLayoutEndCtx(RGLContext *ctx)
+{
+    RGL_STAT_CLOCK(t0);
+    RGLState *st = &ctx->state;
+    RGL_RECORD(ctx, log_op(ctx->recorder, RGL_LOG_END));
+
+    if (st->overflow_depth > 0)
+    {
+        // Close a skipped container, the stack itself is unchanged
+        st->overflow_depth--;
+    }
+    else if (st->top > 0)
+    {
+        st->top--;
+        if (st->stack[st->top].span_base >= 0)
+            st->span_top = st->stack[st->top].span_base; // Cached containers took no span stack room
+        if (ctx->hit != NULL)
+            hit_end(ctx->hit);
+        RGL_TRACE_END(ctx);
+    }
+    else
+    {
+        ctx->errors |= RGL_ERROR_UNBALANCED;
+    }
+    RGL_STAT_CYCLES(ctx, end_cycles, t0);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutRecCtx(RGLContext *ctx, float main, float cross)
+{
+    return GuiLayoutRecExCtx(ctx, main, cross, 0.0f, 0.0f, 0.0f, 0.0f, ctx->default_valign);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutRecAlignCtx(RGLContext *ctx, float main, float cross, RGLVAlign valign)
+{
+    return GuiLayoutRecExCtx(ctx, main, cross, 0.0f, 0.0f, 0.0f, 0.0f, valign);
+}
+
+// Vertical offset of an element shorter than the row it sits in
+static float valign_offset(const RGLContainer *c, float element_height, RGLVAlign valign)
+{
+    float container_height = c->inner.height;
+
+    switch (valign)
+    {
+    case RGL_VALIGN_TOP:
+        // Already at top (default behavior)
+        return 0;
+    case RGL_VALIGN_CENTER:
+        return (container_height - element_height) / 2;
+    case RGL_VALIGN_BOTTOM:
+        return container_height - element_height;
+    case RGL_VALIGN_NONE:
+        // No alignment
+        return 0;
+    }
+    return 0;
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutRecExCtx(RGLContext *ctx, float main, float cross, float pl, float pr, float pt, float pb, RGLVAlign valign)
+{
+    if (ctx->state.top <= 0 || ctx->state.overflow_depth > 0)
+    {
+        // No active container (or a skipped one) - clear last rect and return zero rect
+        RGL_STAT_ADD(ctx, rects, 1);
+        RGL_STAT_ADD(ctx, zero_rects, 1);
+        ctx->last_rect = (Rectangle){0, 0, 0, 0};
+        set_last_id(ctx, NULL, 0);
+        RGL_RECORD(ctx, log_rec(ctx->recorder, main, cross, pl, pr, pt, pb, valign, ctx->last_rect));
+        return ctx->last_rect;
+    }
+
+    RGL_STAT_CLOCK(t0);
+    RGLContainer *c = &ctx->state.stack[ctx->state.top - 1];
+    RGLContainerInfo *info = &ctx->state.info[ctx->state.top - 1];
+    Rectangle result;
+    set_last_id(ctx, info, c->placed);
+
+    if (c->columns == RGL_FLOW)
+    {
+        // FLOW MODE: Next item on the current line, wrapping when it doesn't fit
+        RGL_STAT_ADD(ctx, adhoc, 1);
+        result = take_flow(c, info, &ctx->state.spans[c->span_base], main, cross);
+    }
+    else if (c->columns > 0)
+    {
+        // GRID MODE: Next cell in row-major order (zero rect once every cell was taken)
+        RGL_STAT_ADD(ctx, planned, (c->placed < c->plan_length) ? 1 : 0);
+        RGL_STAT_ADD(ctx, plan_exhausted, (c->placed < c->plan_length) ? 0 : 1);
+        result = (c->placed < c->plan_length) ? grid_cell(c, ctx->state.spans, c->placed / c->columns, c->placed % c->columns, 1, 1) : (Rectangle){0, 0, 0, 0};
+        c->placed++;
+    }
+    else if (c->placed < c->plan_length)
+    {
+        // PLANNED MODE: Use the span resolved at Begin
+        RGL_STAT_ADD(ctx, planned, 1);
+        result = take_span(c, container_spans(&ctx->state, c)[c->placed], cross);
+    }
+    else
+    {
+        // AD-HOC MODE
+        RGL_STAT_ADD(ctx, adhoc, 1);
+        RGL_STAT_ADD(ctx, plan_exhausted, (c->plan_length > 0) ? 1 : 0);
+        float main_px = (main < 0) ? c->remaining : main;
+        result = take_rect(c, main_px, cross);
+    }
+
+    // Apply vertical alignment before padding (grid cells already span their row)
+    if (valign != RGL_VALIGN_NONE && c->axis == RGL_AXIS_ROW && c->columns == 0)
+    {
+        if (result.height < c->inner.height)
+            result.y += valign_offset(c, result.height, valign);
+    }
+
+    // Apply padding if specified
+    if (pl != 0 || pt != 0 || pr != 0 || pb != 0)
+    {
+        result.x += pl;
+        result.y += pt;
+        result.width -= (pl + pr);
+        result.height -= (pt + pb);
+
+        // Clamp to prevent negative sizes
+        if (result.width < 0)
+            result.width = 0;
+        if (result.height < 0)
+            result.height = 0;
+    }
+
+    // Save last produced rectangle
+    ctx->last_rect = result;
+    if (ctx->hit != NULL || ctx->commands != NULL || ctx->damage != NULL)
+        record_rect(ctx, result);
+
+    RGL_STAT_ADD(ctx, rects, 1);
+    RGL_STAT_ADD(ctx, zero_rects, (result.width <= 0 || result.height <= 0) ? 1 : 0);
+    RGL_RECORD(ctx, log_rec(ctx->recorder, main, cross, pl, pr, pt, pb, valign, result));
+    RGL_STAT_CYCLES(ctx, rec_cycles, t0);
+    return result;
+}
+
+// Emit 'count' rects exactly as repeated GuiLayoutRec(main, cross) calls would, in SoA form
+// NOTE: Planned children read independent spans, so that loop has no carried dependency and vectorizes;
+// ad-hoc children depend on the previous cursor and run as a tight scalar loop
+RGLAYOUTAPI int GuiLayoutRecNCtx(RGLContext *ctx, int count, float main, float cross, float *out_x, float *out_y, float *out_w, float *out_h)
+{
+    RGLState *st = &ctx->state;
+    if (count <= 0 || out_x == NULL || out_y == NULL || out_w == NULL || out_h == NULL)
+        return 0;
+
+    // Grids, flows and empty stacks keep their per-item path (logged as one batch)
+    if (st->top <= 0 || st->overflow_depth > 0 || st->stack[st->top - 1].columns != 0)
+    {
+        RGLRecorder *recorder = ctx->recorder;
+        ctx->recorder = NULL;
+        for (int i = 0; i < count; i++)
+        {
+            Rectangle r = GuiLayoutRecExCtx(ctx, main, cross, 0.0f, 0.0f, 0.0f, 0.0f, ctx->default_valign);
+            out_x[i] = r.x;
+            out_y[i] = r.y;
+            out_w[i] = r.width;
+            out_h[i] = r.height;
+        }
+        ctx->recorder = recorder;
+        RGL_RECORD(ctx, log_recn(ctx->recorder, count, main, cross, ctx->default_valign, out_x, out_y, out_w, out_h));
+        return count;
+    }
+
+    RGL_STAT_CLOCK(t0);
+    RGLContainer *c = &st->stack[st->top - 1];
+    const RGLContainerInfo *info = &st->info[st->top - 1];
+    bool row = is_row(c);
+    bool align = (ctx->default_valign != RGL_VALIGN_NONE) && row;
+    int first_slot = c->placed;
+    ctx->next_key = 0; // Batched rects are identified by sibling index
+
+    // Cross size is the same for every child: clamp and align once
+    float cross_fill = cross_size(c->inner, row);
+    float cr = (cross < 0 || cross > cross_fill) ? cross_fill : cross;
+    float cross_pos = row ? c->inner.y : c->inner.x;
+    if (align && cr < c->inner.height)
+        cross_pos += valign_offset(c, cr, ctx->default_valign);
+
+    float *RGL_RESTRICT mx = row ? out_x : out_y; // Main axis position
+    float *RGL_RESTRICT ms = row ? out_w : out_h; // Main axis size
+    float *RGL_RESTRICT cx = row ? out_y : out_x; // Cross axis position
+    float *RGL_RESTRICT cs = row ? out_h : out_w; // Cross axis size
+
+    // PLANNED MODE: straight copy of resolved spans
+    int planned = c->plan_length - c->placed;
+    if (planned > count)
+        planned = count;
+    if (planned > 0)
+    {
+        const RGLSpan *RGL_RESTRICT spans = container_spans(st, c) + c->placed;
+        for (int i = 0; i < planned; i++)
+        {
+            mx[i] = spans[i].offset;
+            ms[i] = spans[i].size;
+            cx[i] = cross_pos;
+            cs[i] = cr;
+        }
+
+        // Same per-child updates as take_span
+        for (int i = 0; i < planned; i++)
+            c->remaining -= spans[i].size;
+        c->cursor = spans[planned - 1].offset + spans[planned - 1].size;
+        c->placed += planned;
+    }
+
+    // AD-HOC MODE: take_rect inlined, cross values stay hoisted
+    float gap = (c->gap > 0) ? c->gap : 0;
+    for (int i = (planned > 0) ? planned : 0; i < count; i++)
+    {
+        if (c->placed > 0 && gap > 0)
+        {
+            c->cursor += gap;
+            if (c->plan_length == 0)
+                c->remaining -= gap;
+        }
+
+        float m = (main < 0) ? c->remaining : main;
+        if (m > c->remaining)
+            m = c->remaining;
+        if (m < 0)
+            m = 0;
+
+        mx[i] = c->cursor;
+        ms[i] = m;
+        cx[i] = cross_pos;
+        cs[i] = cr;
+        c->cursor += m;
+        c->remaining -= m;
+        c->placed++;
+    }
+
+    ctx->last_rect = (Rectangle){out_x[count - 1], out_y[count - 1], out_w[count - 1], out_h[count - 1]};
+    if (ctx->hit != NULL || ctx->commands != NULL || ctx->damage != NULL)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            set_last_id(ctx, info, first_slot + i);
+            record_rect(ctx, (Rectangle){out_x[i], out_y[i], out_w[i], out_h[i]});
+        }
+    }
+    set_last_id(ctx, info, first_slot + count - 1);
+
+#if defined(RGLAYOUT_ENABLE_STATS)
+    int from_plan = (planned > 0) ? planned : 0;
+    ctx->stats.rects += count;
+    ctx->stats.planned += from_plan;
+    ctx->stats.adhoc += count - from_plan;
+    if (c->plan_length > 0)
+        ctx->stats.plan_exhausted += count - from_plan;
+    for (int i = 0; i < count; i++)
+        ctx->stats.zero_rects += (out_w[i] <= 0 || out_h[i] <= 0) ? 1 : 0;
+#endif
+    RGL_RECORD(ctx, log_recn(ctx->recorder, count, main, cross, ctx->default_valign, out_x, out_y, out_w, out_h));
+    RGL_STAT_CYCLES(ctx, rec_cycles, t0);
+    return count;
+}
+
+// New: return copy of last produced rectangle
+RGLAYOUTAPI Rectangle GuiLayoutRecLastCtx(RGLContext *ctx)
+{
+    return ctx->last_rect;
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutPanelCtx(RGLContext *ctx, float main, float cross, float pad_top, float pad_other, RGLPad *out_pad)
+{
+    Rectangle r = GuiLayoutRecCtx(ctx, main, cross);
+    if (out_pad != NULL)
+    {
+        *out_pad = (RGLPad){pad_other, pad_top, pad_other, pad_other};
+    }
+    return r;
+}
+
+RGLAYOUTAPI int GuiLayoutPlanRecsCtx(RGLContext *ctx, Rectangle *out, int capacity)
+{
+    if (ctx->state.top <= 0 || ctx->state.overflow_depth > 0)
+        return 0;
+
+    const RGLContainer *c = &ctx->state.stack[ctx->state.top - 1];
+    const RGLSpan *spans = container_spans(&ctx->state, c);
+    int count = (c->plan_length < capacity) ? c->plan_length : capacity;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (c->columns > 0)
+            out[i] = grid_cell(c, ctx->state.spans, i / c->columns, i % c->columns, 1, 1);
+        else
+            out[i] = span_rect(c, spans[i].offset, spans[i].size, -1);
+    }
+
+    return c->plan_length;
+}
+
+// ===== CURRENT CONTEXT WRAPPERS =====
+
+RGLAYOUTAPI void GuiBeginRow(Rectangle bounds, const RGLPlan *plan)
+{
+    GuiBeginRowCtx(rgl_ctx(), bounds, plan);
+}
+
+RGLAYOUTAPI void GuiBeginRowEx(Rectangle bounds, RGLPad pad, float gap, const RGLPlan *plan)
+{
+    GuiBeginRowExCtx(rgl_ctx(), bounds, pad, gap, plan);
+}
+
+RGLAYOUTAPI void GuiBeginColumn(Rectangle bounds, const RGLPlan *plan)
+{
+    GuiBeginColumnCtx(rgl_ctx(), bounds, plan);
+}
+
+RGLAYOUTAPI void GuiBeginColumnEx(Rectangle bounds, RGLPad pad, float gap, const RGLPlan *plan)
+{
+    GuiBeginColumnExCtx(rgl_ctx(), bounds, pad, gap, plan);
+}
+
+RGLAYOUTAPI void GuiBeginRowResponsive(Rectangle bounds, const RGLBreakpoint *breakpoints, int count)
+{
+    GuiBeginRowResponsiveCtx(rgl_ctx(), bounds, breakpoints, count);
+}
+
+RGLAYOUTAPI void GuiBeginColumnResponsive(Rectangle bounds, const RGLBreakpoint *breakpoints, int count)
+{
+    GuiBeginColumnResponsiveCtx(rgl_ctx(), bounds, breakpoints, count);
+}
+
+RGLAYOUTAPI RGLRange GuiBeginScrollRow(Rectangle bounds, float scroll, int count, float item_size)
+{
+    return GuiBeginScrollRowCtx(rgl_ctx(), bounds, scroll, count, item_size);
+}
+
+RGLAYOUTAPI RGLRange GuiBeginScrollRowEx(Rectangle bounds, RGLPad pad, float gap, float scroll, int count, float item_size, const RGLScrollIndex *index)
+{
+    return GuiBeginScrollRowExCtx(rgl_ctx(), bounds, pad, gap, scroll, count, item_size, index);
+}
+
+RGLAYOUTAPI RGLRange GuiBeginScrollColumn(Rectangle bounds, float scroll, int count, float item_size)
+{
+    return GuiBeginScrollColumnCtx(rgl_ctx(), bounds, scroll, count, item_size);
+}
+
+RGLAYOUTAPI RGLRange GuiBeginScrollColumnEx(Rectangle bounds, RGLPad pad, float gap, float scroll, int count, float item_size, const RGLScrollIndex *index)
+{
+    return GuiBeginScrollColumnExCtx(rgl_ctx(), bounds, pad, gap, scroll, count, item_size, index);
+}
+
+RGLAYOUTAPI void GuiBeginFlow(Rectangle bounds, float line_size)
+{
+    GuiBeginFlowCtx(rgl_ctx(), bounds, line_size);
+}
+
+RGLAYOUTAPI void GuiBeginFlowEx(Rectangle bounds, RGLPad pad, float gap, float line_size)
+{
+    GuiBeginFlowExCtx(rgl_ctx(), bounds, pad, gap, line_size);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutContentSize(void)
+{
+    return GuiLayoutContentSizeCtx(rgl_ctx());
+}
+
+RGLAYOUTAPI void GuiBeginGrid(Rectangle bounds, const RGLPlan *col_plan, const RGLPlan *row_plan)
+{
+    GuiBeginGridCtx(rgl_ctx(), bounds, col_plan, row_plan);
+}
+
+RGLAYOUTAPI void GuiBeginGridEx(Rectangle bounds, RGLPad pad, float gap, const RGLPlan *col_plan, const RGLPlan *row_plan)
+{
+    GuiBeginGridExCtx(rgl_ctx(), bounds, pad, gap, col_plan, row_plan);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutCell(int row, int col)
+{
+    return GuiLayoutCellSpanCtx(rgl_ctx(), row, col, 1, 1);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutCellSpan(int row, int col, int row_span, int col_span)
+{
+    return GuiLayoutCellSpanCtx(rgl_ctx(), row, col, row_span, col_span);
+}
+
+RGLAYOUTAPI void RGLSetLayoutCache(RGLLayoutCache *cache)
+{
+    RGLSetLayoutCacheCtx(rgl_ctx(), cache);
+}
+
+RGLAYOUTAPI void GuiLayoutSetNextId(unsigned int id)
+{
+    GuiLayoutSetNextIdCtx(rgl_ctx(), id);
+}
+
+RGLAYOUTAPI void RGLSetHitIndex(RGLHitIndex *index)
+{
+    RGLSetHitIndexCtx(rgl_ctx(), index);
+}
+
+RGLAYOUTAPI void RGLSetCommandBuffer(RGLCommandBuffer *buffer)
+{
+    RGLSetCommandBufferCtx(rgl_ctx(), buffer);
+}
+
+RGLAYOUTAPI void RGLSetDamage(RGLDamage *damage)
+{
+    RGLSetDamageCtx(rgl_ctx(), damage);
+}
+
+RGLAYOUTAPI void RGLSetTextMeasure(RGLGlyphAdvanceFunc measure_fn, void *user)
+{
+    RGLSetTextMeasureCtx(rgl_ctx(), measure_fn, user);
+}
+
+RGLAYOUTAPI void RGLSetTextFont(const void *font, float size, float spacing)
+{
+    RGLSetTextFontCtx(rgl_ctx(), font, size, spacing);
+}
+
+RGLAYOUTAPI void RGLSetTextCache(RGLTextCache *cache)
+{
+    RGLSetTextCacheCtx(rgl_ctx(), cache);
+}
+
+RGLAYOUTAPI Rectangle RGLMeasureText(const char *text)
+{
+    return RGLMeasureTextCtx(rgl_ctx(), text);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutRecText(const char *text, float pad, float cross)
+{
+    return GuiLayoutRecTextCtx(rgl_ctx(), text, pad, cross);
+}
+
+RGLAYOUTAPI unsigned int GuiLayoutIdLast(void)
+{
+    return GuiLayoutIdLastCtx(rgl_ctx());
+}
+
+RGLAYOUTAPI unsigned int GuiLayoutIdCurrent(void)
+{
+    return GuiLayoutIdCurrentCtx(rgl_ctx());
+}
+
+RGLAYOUTAPI void GuiLayoutSetNextKey(unsigned int key)
+{
+    GuiLayoutSetNextKeyCtx(rgl_ctx(), key);
+}
+
+RGLAYOUTAPI void RGLSetTrace(RGLTraceBuffer *buffer)
+{
+    RGLSetTraceCtx(rgl_ctx(), buffer);
+}
+
+RGLAYOUTAPI void GuiLayoutSetNextZone(const char *name)
+{
+    GuiLayoutSetNextZoneCtx(rgl_ctx(), name);
+}
+
+RGLAYOUTAPI void RGLSetRecorder(RGLRecorder *recorder)
+{
+    RGLSetRecorderCtx(rgl_ctx(), recorder);
+}
+
+RGLAYOUTAPI RGLReplayResult RGLReplay(const void *log, size_t size, RGLArena *scratch)
+{
+    return RGLReplayCtx(rgl_ctx(), log, size, scratch);
+}
+
+RGLAYOUTAPI void GuiLayoutMarkDirty(void)
+{
+    GuiLayoutMarkDirtyCtx(rgl_ctx());
+}
+
+RGLAYOUTAPI void GuiLayoutSetNextTag(unsigned int tag)
+{
+    GuiLayoutSetNextTagCtx(rgl_ctx(), tag);
+}
+
+RGLAYOUTAPI void RGLSetArena(RGLArena *arena)
+{
+    RGLSetArenaCtx(rgl_ctx(), arena);
+}
+
+RGLAYOUTAPI void RGLSetAllocator(RGLReallocFunc alloc_fn, void *user)
+{
+    RGLSetAllocatorCtx(rgl_ctx(), alloc_fn, user);
+}
+
+RGLAYOUTAPI void RGLBeginFrame(void)
+{
+    RGLBeginFrameCtx(rgl_ctx());
+}
+
+RGLAYOUTAPI int RGLGetErrors(void)
+{
+    return RGLGetErrorsCtx(rgl_ctx());
+}
+
+RGLAYOUTAPI RGLFrameStats RGLGetFrameStats(void)
+{
+    return RGLGetFrameStatsCtx(rgl_ctx());
+}
+
+RGLAYOUTAPI void GuiLayoutEnd(void)
+{
+    GuiLayoutEndCtx(rgl_ctx());
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutRec(float main, float cross)
+{
+    RGLContext *ctx = rgl_ctx();
+    return GuiLayoutRecExCtx(ctx, main, cross, 0.0f, 0.0f, 0.0f, 0.0f, ctx->default_valign);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutRecAlign(float main, float cross, RGLVAlign valign)
+{
+    return GuiLayoutRecExCtx(rgl_ctx(), main, cross, 0.0f, 0.0f, 0.0f, 0.0f, valign);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutRecEx(float main, float cross, float pl, float pr, float pt, float pb, RGLVAlign valign)
+{
+    return GuiLayoutRecExCtx(rgl_ctx(), main, cross, pl, pr, pt, pb, valign);
+}
+
+RGLAYOUTAPI int GuiLayoutRecN(int count, float main, float cross, float *out_x, float *out_y, float *out_w, float *out_h)
+{
+    return GuiLayoutRecNCtx(rgl_ctx(), count, main, cross, out_x, out_y, out_w, out_h);
+}
+
+RGLAYOUTAPI int GuiLayoutPlanRecs(Rectangle *out, int capacity)
+{
+    return GuiLayoutPlanRecsCtx(rgl_ctx(), out, capacity);
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutRecLast(void)
+{
+    return GuiLayoutRecLastCtx(rgl_ctx());
+}
+
+RGLAYOUTAPI Rectangle GuiLayoutPanel(float main, float cross, float pad_top, float pad_other, RGLPad *out_pad)
+{
+    return GuiLayoutPanelCtx(rgl_ctx(), main, cross, pad_top, pad_other, out_pad);
+}
+
+RGLAYOUTAPI void RGLTreeBegin(RGLTree *tree, RGLNode *nodes, int capacity)
+{
+    RGLTreeBeginCtx(rgl_ctx(), tree, nodes, capacity);
+}
+
+// ===== DEFERRED LAYOUT TREE =====
+
+// Fill request: negative but not RGL_FIT
+static bool tree_is_fill(float req)
+{
+    return (req < 0) && (req != RGL_FIT);
+}
+
+// Append a node under the open container
+static RGLNodeId tree_push(RGLTree *tree, float main, float cross, bool container)
+{
+    if (tree->skip_depth > 0 || tree->count >= tree->capacity)
+    {
+        tree->overflow = true;
+        if (container)
+            tree->skip_depth++;
+        return RGL_NODE_NONE;
+    }
+
+    RGLNodeId id = tree->count++;
+    RGLNode *n = &tree->nodes[id];
+    memset(n, 0, sizeof(*n));
+    tree->solved = false;
+
+    // Store requests as width/height, main follows the parent axis (roots: main is width)
+    bool parent_row = (tree->current == RGL_NODE_NONE) || (tree->nodes[tree->current].axis == RGL_AXIS_ROW);
+    n->req_w = parent_row ? main : cross;
+    n->req_h = parent_row ? cross : main;
+    n->parent = tree->current;
+    n->subtree = 1;
+    n->container = container;
+
+    if (tree->current != RGL_NODE_NONE)
+        tree->nodes[tree->current].children++;
+    if (container)
+        tree->current = id;
+
+    return id;
+}
+
+static RGLNodeId tree_begin(RGLTree *tree, float main, float cross, RGLAxis axis, RGLPad pad, float gap)
+{
+    RGLNodeId id = tree_push(tree, main, cross, true);
+    if (id != RGL_NODE_NONE)
     {
-        // Horizontal layout
-        r = (Rectangle){
-            .x = c->cursor,
-            .y = c->inner.y,
-            .width = m,
-            .height = cr};
-        c->cursor += m;
-        c->remaining -= m;
+        tree->nodes[id].axis = axis;
+        tree->nodes[id].pad = pad;
+        tree->nodes[id].gap = gap;
     }
-    else
+    return id;
+}
+
+RGLAYOUTAPI void RGLTreeBeginCtx(RGLContext *ctx, RGLTree *tree, RGLNode *nodes, int capacity)
+{
+    tree->nodes = nodes;
+    tree->count = 0;
+    tree->capacity = (nodes != NULL && capacity > 0) ? capacity : 0;
+    tree->current = RGL_NODE_NONE;
+    tree->skip_depth = 0;
+    tree->overflow = false;
+    tree->solved = false;
+    tree->default_pad = ctx->default_pad;
+    tree->default_gap = ctx->default_gap;
+}
+
+RGLAYOUTAPI RGLNodeId RGLTreeBeginRow(RGLTree *tree, float main, float cross)
+{
+    return tree_begin(tree, main, cross, RGL_AXIS_ROW, tree->default_pad, tree->default_gap);
+}
+
+RGLAYOUTAPI RGLNodeId RGLTreeBeginRowEx(RGLTree *tree, float main, float cross, RGLPad pad, float gap)
+{
+    return tree_begin(tree, main, cross, RGL_AXIS_ROW, pad, gap);
+}
+
+RGLAYOUTAPI RGLNodeId RGLTreeBeginColumn(RGLTree *tree, float main, float cross)
+{
+    return tree_begin(tree, main, cross, RGL_AXIS_COLUMN, tree->default_pad, tree->default_gap);
+}
+
+RGLAYOUTAPI RGLNodeId RGLTreeBeginColumnEx(RGLTree *tree, float main, float cross, RGLPad pad, float gap)
+{
+    return tree_begin(tree, main, cross, RGL_AXIS_COLUMN, pad, gap);
+}
+
+RGLAYOUTAPI void RGLTreeEnd(RGLTree *tree)
+{
+    if (tree->skip_depth > 0)
     {
-        // Vertical layout
-        r = (Rectangle){
-            .x = c->inner.x,
-            .y = c->cursor,
-            .width = cr,
-            .height = m};
-        c->cursor += m;
-        c->remaining -= m;
+        tree->skip_depth--;
+        return;
     }
+    if (tree->current == RGL_NODE_NONE)
+        return;
 
-    c->placed++;
-    return r;
+    // Subtree is contiguous in preorder: everything recorded since the container was opened
+    RGLNode *n = &tree->nodes[tree->current];
+    n->subtree = tree->count - tree->current;
+    tree->current = n->parent;
 }
 
-// ===== PUBLIC API =====
+RGLAYOUTAPI RGLNodeId RGLTreeRec(RGLTree *tree, float main, float cross)
+{
+    return tree_push(tree, main, cross, false);
+}
 
-RGLAYOUTAPI void GuiBeginRow(Rectangle bounds, RGLPlan *plan)
+RGLAYOUTAPI RGLNodeId RGLTreeRecContent(RGLTree *tree, float main, float cross, float content_w, float content_h)
 {
-    RGLPlan empty_plan = {0};
-    RGLPlan actual_plan = plan ? *plan : empty_plan;
-    GuiBeginRowEx(bounds, g_default_pad, g_default_gap, &actual_plan);
+    RGLNodeId id = tree_push(tree, main, cross, false);
+    if (id != RGL_NODE_NONE)
+    {
+        tree->nodes[id].content_w = content_w;
+        tree->nodes[id].content_h = content_h;
+    }
+    return id;
 }
 
-RGLAYOUTAPI void GuiBeginRowEx(Rectangle bounds, RGLPad pad, float gap, RGLPlan *plan)
+// Bottom-up measure: children have larger indices than their parent, so a reverse sweep
+// sees every child before its parent
+static void tree_measure(RGLNode *nodes, int count)
 {
-    RGLContainer c;
-    RGLPlan empty_plan = {0};
-    RGLPlan actual_plan = plan ? *plan : empty_plan;
-    init_common(&c, bounds, RGL_AXIS_ROW, pad, gap, actual_plan);
-    if (g_rgl.top < RGL_MAX_STACK)
+    for (int i = 0; i < count; i++)
     {
-        g_rgl.stack[g_rgl.top] = c;
-        g_rgl.top++;
+        RGLNode *n = &nodes[i];
+        n->acc_main = 0;
+        n->acc_cross = 0;
+        n->fixed_main = 0;
+        n->fill_count = 0;
+    }
+
+    for (int i = count - 1; i >= 0; i--)
+    {
+        RGLNode *n = &nodes[i];
+
+        if (n->container)
+        {
+            bool row = (n->axis == RGL_AXIS_ROW);
+            float gaps = (n->children > 1) ? (n->children - 1) * n->gap : 0;
+            float content_main = n->acc_main + gaps;
+            n->content_w = (row ? content_main : n->acc_cross) + n->pad.left + n->pad.right;
+            n->content_h = (row ? n->acc_cross : content_main) + n->pad.top + n->pad.bottom;
+        }
+
+        if (n->parent == RGL_NODE_NONE)
+            continue;
+
+        // Contribute preferred size to the parent (fill nodes contribute their content)
+        RGLNode *p = &nodes[n->parent];
+        bool prow = (p->axis == RGL_AXIS_ROW);
+        float pref_w = (n->req_w >= 0) ? n->req_w : n->content_w;
+        float pref_h = (n->req_h >= 0) ? n->req_h : n->content_h;
+        float pref_main = prow ? pref_w : pref_h;
+        float pref_cross = prow ? pref_h : pref_w;
+
+        p->acc_main += pref_main;
+        if (pref_cross > p->acc_cross)
+            p->acc_cross = pref_cross;
+
+        if (tree_is_fill(prow ? n->req_w : n->req_h))
+            p->fill_count++;
+        else
+            p->fixed_main += pref_main;
     }
 }
 
-RGLAYOUTAPI void GuiBeginColumn(Rectangle bounds, RGLPlan *plan)
+// Prepare a solved container for placing its children
+static void tree_open(RGLNode *n)
 {
-    RGLPlan empty_plan = {0};
-    RGLPlan actual_plan = plan ? *plan : empty_plan;
-    GuiBeginColumnEx(bounds, g_default_pad, g_default_gap, &actual_plan);
+    bool row = (n->axis == RGL_AXIS_ROW);
+    n->inner = shrink_rect(n->rect, n->pad);
+    n->cursor = row ? n->inner.x : n->inner.y;
+    n->remaining = main_size(n->inner, row);
+
+    float gaps = (n->children > 1) ? (n->children - 1) * n->gap : 0;
+    float leftover = n->remaining - n->fixed_main - gaps;
+    if (leftover < 0)
+        leftover = 0;
+    n->fill_size = (n->fill_count > 0) ? leftover / (float)n->fill_count : 0;
+    n->placed = 0;
 }
 
-RGLAYOUTAPI void GuiBeginColumnEx(Rectangle bounds, RGLPad pad, float gap, RGLPlan *plan)
+// Place a node inside its (already solved) parent, same clamping rules as take_rect()
+static void tree_place(RGLNode *nodes, RGLNode *n)
 {
-    RGLContainer c;
-    RGLPlan empty_plan = {0};
-    RGLPlan actual_plan = plan ? *plan : empty_plan;
-    init_common(&c, bounds, RGL_AXIS_COLUMN, pad, gap, actual_plan);
-    if (g_rgl.top < RGL_MAX_STACK)
+    RGLNode *p = &nodes[n->parent];
+    bool row = (p->axis == RGL_AXIS_ROW);
+
+    float req_main = row ? n->req_w : n->req_h;
+    float req_cross = row ? n->req_h : n->req_w;
+
+    float m;
+    if (req_main >= 0)
+        m = req_main;
+    else if (req_main == RGL_FIT)
+        m = row ? n->content_w : n->content_h;
+    else
+        m = p->fill_size;
+
+    // Gap before every child but the first
+    if (p->placed > 0)
     {
-        g_rgl.stack[g_rgl.top] = c;
-        g_rgl.top++;
+        p->cursor += p->gap;
+        p->remaining -= p->gap;
     }
+
+    if (m > p->remaining)
+        m = p->remaining;
+    if (m < 0)
+        m = 0;
+
+    float cross_fill = cross_size(p->inner, row);
+    float cr;
+    if (req_cross >= 0)
+        cr = req_cross;
+    else if (req_cross == RGL_FIT)
+        cr = row ? n->content_h : n->content_w;
+    else
+        cr = cross_fill;
+    if (cr > cross_fill)
+        cr = cross_fill;
+
+    n->rect = row ? (Rectangle){p->cursor, p->inner.y, m, cr} : (Rectangle){p->inner.x, p->cursor, cr, m};
+    p->cursor += m;
+    p->remaining -= m;
+    p->placed++;
 }
 
-RGLAYOUTAPI void GuiLayoutEnd(void)
+// Top-down arrange of nodes [first, end) whose parents are already solved or inside the range
+static void tree_arrange_range(RGLNode *nodes, int first, int end)
 {
-    if (g_rgl.top > 0)
+    for (int i = first; i < end; i++)
     {
-        g_rgl.top--;
+        RGLNode *n = &nodes[i];
+        tree_place(nodes, n);
+        if (n->container)
+            tree_open(n);
     }
 }
 
-RGLAYOUTAPI Rectangle GuiLayoutRec(float main, float cross)
+// Re-arrange nodes [first, end) of a solved tree, returns the number of nodes placed
+// NOTE: A child rect depends only on its parent's rect and the measured sizes, so a container
+// placed at its previous rect keeps its whole subtree and is not opened again
+static int tree_rearrange_range(RGLNode *nodes, int first, int end)
 {
-    return GuiLayoutRecEx(main, cross, 0.0f, 0.0f, 0.0f, 0.0f, g_default_valign);
+    int placed = 0;
+    for (int i = first; i < end; i++)
+    {
+        RGLNode *n = &nodes[i];
+        Rectangle previous = n->rect;
+        tree_place(nodes, n);
+        placed++;
+        if (!n->container)
+            continue;
+        if (rect_equal(previous, n->rect))
+            i += n->subtree - 1;
+        else
+            tree_open(n);
+    }
+    return placed;
 }
 
-RGLAYOUTAPI Rectangle GuiLayoutRecAlign(float main, float cross, RGLVAlign valign)
+// Place a root node in the solve bounds (main is width, cross is height)
+static void tree_place_root(RGLNode *n, Rectangle bounds)
 {
-    return GuiLayoutRecEx(main, cross, 0.0f, 0.0f, 0.0f, 0.0f, valign);
+    float w = (n->req_w >= 0) ? n->req_w : (n->req_w == RGL_FIT) ? n->content_w : bounds.width;
+    float h = (n->req_h >= 0) ? n->req_h : (n->req_h == RGL_FIT) ? n->content_h : bounds.height;
+    n->rect = (Rectangle){bounds.x, bounds.y, w, h};
+    if (n->container)
+        tree_open(n);
 }
 
+RGLAYOUTAPI void RGLTreeSolve(RGLTree *tree, Rectangle bounds)
+{
+    // Close containers left open so subtree ranges are valid
+    while (tree->current != RGL_NODE_NONE)
+        RGLTreeEnd(tree);
+
+    tree_measure(tree->nodes, tree->count);
 
-RGLAYOUTAPI Rectangle GuiLayoutRecEx(float main, float cross, float pl, float pr, float pt, float pb, RGLVAlign valign)
+    for (int i = 0; i < tree->count; i += tree->nodes[i].subtree)
+    {
+        tree_place_root(&tree->nodes[i], bounds);
+        tree_arrange_range(tree->nodes, i + 1, i + tree->nodes[i].subtree);
+    }
+    tree->solved = true;
+}
+
+// Solve again with new bounds (window resize), reusing the previous solve of the same recording
+// NOTE: Measured sizes don't depend on the bounds, only subtrees whose outer rect changed are
+// re-arranged. Without a previous solve (or after recording nodes) this is a full RGLTreeSolve()
+RGLAYOUTAPI int RGLTreeSolveIncremental(RGLTree *tree, Rectangle bounds)
 {
-    if (g_rgl.top <= 0)
+    if (!tree->solved || tree->current != RGL_NODE_NONE)
     {
-        // No active container - clear last rect and return zero rect
-        g_last_rect = (Rectangle){0, 0, 0, 0};
-        return g_last_rect;
+        RGLTreeSolve(tree, bounds);
+        return tree->count;
     }
 
-    RGLContainer *c = &g_rgl.stack[g_rgl.top - 1];
-    Rectangle result;
+    int placed = 0;
+    for (int i = 0; i < tree->count; i += tree->nodes[i].subtree)
+    {
+        RGLNode *root = &tree->nodes[i];
+        Rectangle previous = root->rect;
+        tree_place_root(root, bounds);
+        placed++;
+        if (!rect_equal(previous, root->rect))
+            placed += tree_rearrange_range(tree->nodes, i + 1, i + root->subtree);
+    }
+    return placed;
+}
 
-    // PLANNED MODE: Use the layout plan to determine sizing
-    if (c->plan.length > 0 && c->plan_index < c->plan.length)
+RGLAYOUTAPI Rectangle RGLTreeRect(const RGLTree *tree, RGLNodeId node)
+{
+    if (node < 0 || node >= tree->count)
+        return (Rectangle){0, 0, 0, 0};
+    return tree->nodes[node].rect;
+}
+
+RGLAYOUTAPI Rectangle RGLTreeContentSize(const RGLTree *tree, RGLNodeId node)
+{
+    if (node < 0 || node >= tree->count)
+        return (Rectangle){0, 0, 0, 0};
+    return (Rectangle){0, 0, tree->nodes[node].content_w, tree->nodes[node].content_h};
+}
+
+// ===== PARALLEL TREE SOLVE =====
+
+#if defined(RGLAYOUT_ENABLE_THREADS) && !defined(_WIN32)
+
+static void pool_lock(int *lock)
+{
+    while (__atomic_test_and_set(lock, __ATOMIC_ACQUIRE))
+        sched_yield();
+}
+
+static void pool_unlock(int *lock)
+{
+    __atomic_clear(lock, __ATOMIC_RELEASE);
+}
+
+static bool deque_push(RGLWorkDeque *d, int task)
+{
+    bool ok = false;
+    pool_lock(&d->lock);
+    if (d->tail - d->head < RGL_POOL_DEQUE_SIZE)
     {
-        float v = c->plan.sizes[c->plan_index];
-        c->plan_index++;
+        d->tasks[d->tail % RGL_POOL_DEQUE_SIZE] = task;
+        d->tail++;
+        ok = true;
+    }
+    pool_unlock(&d->lock);
+    return ok;
+}
 
-        float main_px;
-        if (v >= 20)
-        {
-            // Fixed pixel size
-            main_px = v;
-        }
-        else if (v == -1)
-        {
-            // Fill remaining space (flex weight of 1)
-            bool row = (c->axis == RGL_AXIS_ROW);
-            float avail = row ? c->inner.width : c->inner.height;
+// Owner end: newest task first (depth-first, cache friendly)
+static bool deque_pop(RGLWorkDeque *d, int *task)
+{
+    bool ok = false;
+    pool_lock(&d->lock);
+    if (d->tail > d->head)
+    {
+        d->tail--;
+        *task = d->tasks[d->tail % RGL_POOL_DEQUE_SIZE];
+        ok = true;
+    }
+    pool_unlock(&d->lock);
+    return ok;
+}
 
-            float space_for_flex = avail - c->plan_sum_fixed - c->plan_gap_total;
-            if (space_for_flex < 0)
-                space_for_flex = 0;
+// Thief end: oldest task first (largest remaining subtrees)
+static bool deque_steal(RGLWorkDeque *d, int *task)
+{
+    bool ok = false;
+    pool_lock(&d->lock);
+    if (d->tail > d->head)
+    {
+        *task = d->tasks[d->head % RGL_POOL_DEQUE_SIZE];
+        d->head++;
+        ok = true;
+    }
+    pool_unlock(&d->lock);
+    return ok;
+}
 
-            if (c->plan_sum_weight > 0)
-            {
-                float weight_ratio = 1.0f / c->plan_sum_weight;
-                main_px = weight_ratio * space_for_flex;
-            }
-            else
-            {
-                main_px = space_for_flex;
-            }
-        }
-        else if (v > 0 && v < 20)
-        {
-            // Flex weight (0-19)
-            bool row = (c->axis == RGL_AXIS_ROW);
-            float avail = row ? c->inner.width : c->inner.height;
+// Arrange the children of an opened container, handing large child subtrees to the pool
+// NOTE: Each task only writes nodes inside its own subtree, placement order per parent is unchanged
+static void pool_arrange_children(RGLThreadPool *pool, int self, int root)
+{
+    RGLNode *nodes = pool->nodes;
+    int end = root + nodes[root].subtree;
 
-            float space_for_flex = avail - c->plan_sum_fixed - c->plan_gap_total;
-            if (space_for_flex < 0)
-                space_for_flex = 0;
+    for (int j = root + 1; j < end; j += nodes[j].subtree)
+    {
+        RGLNode *n = &nodes[j];
+        tree_place(nodes, n);
+        if (!n->container)
+            continue;
 
-            if (c->plan_sum_weight > 0)
-            {
-                float weight_ratio = v / c->plan_sum_weight;
-                main_px = weight_ratio * space_for_flex;
-            }
-            else
-            {
-                main_px = 0;
-            }
+        tree_open(n);
+        if (n->subtree >= pool->task_nodes)
+        {
+            __atomic_add_fetch(&pool->pending, 1, __ATOMIC_ACQ_REL);
+            if (deque_push(&pool->deques[self], j))
+                continue;
+            __atomic_sub_fetch(&pool->pending, 1, __ATOMIC_ACQ_REL);
         }
-        else
+        tree_arrange_range(nodes, j + 1, j + n->subtree);
+    }
+}
+
+// Run tasks (own deque first, then steal) until the current job has no pending tasks
+static void pool_work(RGLThreadPool *pool, int self)
+{
+    int workers = pool->thread_count + 1;
+
+    while (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) > 0)
+    {
+        int task = -1;
+        bool found = deque_pop(&pool->deques[self], &task);
+        for (int k = 1; !found && k < workers; k++)
+            found = deque_steal(&pool->deques[(self + k) % workers], &task);
+
+        if (!found)
         {
-            // Values < -1 are ignored, treated as 0 size
-            main_px = 0;
+            sched_yield();
+            continue;
         }
 
-        result = take_rect(c, main_px, cross);
+        pool_arrange_children(pool, self, task);
+        __atomic_sub_fetch(&pool->pending, 1, __ATOMIC_ACQ_REL);
     }
-    else
+}
+
+static void *pool_worker_main(void *arg)
+{
+    RGLThreadPool *pool = ((RGLPoolWorker *)arg)->pool;
+    int self = ((RGLPoolWorker *)arg)->index;
+    int seen = 0;
+
+    for (;;)
     {
-        // AD-HOC MODE
-        float main_px = (main < 0) ? c->remaining : main;
-        result = take_rect(c, main_px, cross);
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->generation == seen && !pool->shutdown)
+            pthread_cond_wait(&pool->wake, &pool->mutex);
+        seen = pool->generation;
+        bool stop = pool->shutdown;
+        pthread_mutex_unlock(&pool->mutex);
+
+        if (stop)
+            break;
+        pool_work(pool, self);
     }
 
-    // Apply vertical alignment before padding
-    if (valign != RGL_VALIGN_NONE && c->axis == RGL_AXIS_ROW)
-    {
-        float container_height = c->inner.height;
-        float element_height = result.height;
+    return NULL;
+}
 
-        if (element_height < container_height)
-        {
-            switch (valign)
-            {
-            case RGL_VALIGN_TOP:
-                // Already at top (default behavior)
-                break;
-            case RGL_VALIGN_CENTER:
-            {
-                float offset = (container_height - element_height) / 2;
-                result.y += offset;
-                break;
-            }
-            case RGL_VALIGN_BOTTOM:
-            {
-                float offset = container_height - element_height;
-                result.y += offset;
-                break;
-            }
-            case RGL_VALIGN_NONE:
-                // No alignment
-                break;
-            }
-        }
+RGLAYOUTAPI bool RGLThreadPoolInit(RGLThreadPool *pool, int threads)
+{
+    memset(pool, 0, sizeof(*pool));
+    pool->min_nodes = RGL_PARALLEL_MIN_NODES;
+    pool->task_nodes = RGL_PARALLEL_TASK_NODES;
+
+    if (threads > RGL_POOL_MAX_THREADS)
+        threads = RGL_POOL_MAX_THREADS;
+    if (threads <= 0)
+        return false;
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    for (int i = 0; i < threads; i++)
+    {
+        pool->workers[i] = (RGLPoolWorker){pool, i + 1};
+        if (pthread_create(&pool->threads[i], NULL, pool_worker_main, &pool->workers[i]) != 0)
+            break;
+        pool->thread_count++;
     }
 
-    // Apply padding if specified
-    if (pl != 0 || pt != 0 || pr != 0 || pb != 0)
+    // No worker started: release the sync objects here, a failed Init leaves nothing to close
+    if (pool->thread_count == 0)
     {
-        result.x += pl;
-        result.y += pt;
-        result.width -= (pl + pr);
-        result.height -= (pt + pb);
+        pthread_mutex_destroy(&pool->mutex);
+        pthread_cond_destroy(&pool->wake);
+        return false;
+    }
 
-        // Clamp to prevent negative sizes
-        if (result.width < 0)
-            result.width = 0;
-        if (result.height < 0)
-            result.height = 0;
+    pool->started = true;
+    return true;
+}
+
+RGLAYOUTAPI void RGLThreadPoolClose(RGLThreadPool *pool)
+{
+    if (!pool->started)
+    {
+        pool->thread_count = 0; // Failed Init or already closed
+        return;
     }
 
-    // Save last produced rectangle
-    g_last_rect = result;
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
 
-    return result;
+    for (int i = 0; i < pool->thread_count; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->wake);
+    pool->thread_count = 0;
+    pool->started = false;
 }
 
-// New: return copy of last produced rectangle
-RGLAYOUTAPI Rectangle GuiLayoutRecLast(void)
+// Solve one root subtree on the pool
+static void pool_solve_root(RGLThreadPool *pool, RGLNode *nodes, int root)
+{
+    pool->nodes = nodes;
+    __atomic_store_n(&pool->pending, 1, __ATOMIC_RELEASE);
+    deque_push(&pool->deques[0], root);
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+
+    pool_work(pool, 0);
+}
+
+#else
+
+RGLAYOUTAPI bool RGLThreadPoolInit(RGLThreadPool *pool, int threads)
 {
-    return g_last_rect;
+    (void)threads;
+    memset(pool, 0, sizeof(*pool));
+    pool->min_nodes = RGL_PARALLEL_MIN_NODES;
+    pool->task_nodes = RGL_PARALLEL_TASK_NODES;
+    return false;
 }
 
-RGLAYOUTAPI Rectangle GuiLayoutPanel(float main, float cross, float pad_top, float pad_other, RGLPad *out_pad)
+RGLAYOUTAPI void RGLThreadPoolClose(RGLThreadPool *pool)
 {
-    Rectangle r = GuiLayoutRec(main, cross);
-    if (out_pad != NULL)
+    pool->thread_count = 0;
+}
+
+#endif // RGLAYOUT_ENABLE_THREADS
+
+RGLAYOUTAPI void RGLThreadPoolSetThresholds(RGLThreadPool *pool, int min_nodes, int task_nodes)
+{
+    pool->min_nodes = (min_nodes > 0) ? min_nodes : 0;
+    pool->task_nodes = (task_nodes > 1) ? task_nodes : 2;
+}
+
+RGLAYOUTAPI void RGLTreeSolveParallel(RGLTree *tree, Rectangle bounds, RGLThreadPool *pool)
+{
+    if (pool == NULL || pool->thread_count <= 0 || tree->count < pool->min_nodes)
     {
-        *out_pad = (RGLPad){pad_other, pad_top, pad_other, pad_other};
+        RGLTreeSolve(tree, bounds);
+        return;
     }
-    return r;
+
+    while (tree->current != RGL_NODE_NONE)
+        RGLTreeEnd(tree);
+
+    tree_measure(tree->nodes, tree->count);
+
+    for (int i = 0; i < tree->count; i += tree->nodes[i].subtree)
+    {
+        tree_place_root(&tree->nodes[i], bounds);
+#if defined(RGLAYOUT_ENABLE_THREADS) && !defined(_WIN32)
+        if (tree->nodes[i].container && tree->nodes[i].subtree >= pool->task_nodes)
+        {
+            pool_solve_root(pool, tree->nodes, i);
+            continue;
+        }
+#endif
+        tree_arrange_range(tree->nodes, i + 1, i + tree->nodes[i].subtree);
+    }
+    tree->solved = true;
 }
 
 // ===== PLAN BUILDER FUNCTIONS =====
 
+// Move the plan's entries into a larger arena block (arena plans only)
+static bool plan_grow(RGLPlan *plan, int needed)
+{
+    if (plan->arena == NULL || plan->entries == NULL)
+        return false;
+
+    int capacity = (plan->capacity > 0) ? plan->capacity : RGL_PLAN_MAX;
+    while (capacity < needed)
+    {
+        if (capacity > 0x1fffffff)
+            return false;
+        capacity *= 2;
+    }
+
+    float *block = (float *)RGLArenaAlloc(plan->arena, (size_t)capacity * sizeof(float));
+    if (block == NULL)
+        return false;
+
+    memcpy(block, plan->entries, (size_t)plan->length * sizeof(float));
+    plan->entries = block;
+    plan->capacity = capacity;
+    return true;
+}
+
+// Append one entry and update the plan totals
+static void plan_push(RGLPlan *plan, float size)
+{
+    int capacity = (plan->entries != NULL) ? plan->capacity : RGL_PLAN_MAX;
+    if (plan->length >= capacity && !plan_grow(plan, plan->length + 1))
+        return;
+
+    float *sizes = (plan->entries != NULL) ? plan->entries : plan->sizes;
+    if (plan->length == 0)
+    {
+        // First entry (also of a plan emptied with length = 0 for reuse): start totals and hash over
+        plan->sum_fixed = 0;
+        plan->sum_weight = 0;
+        plan->hash = RGL__PLAN_SEED;
+    }
+    if (plan->hash != 0)
+        plan->hash += RGL__ENTRY_HASH(size, plan->length); // 0: not maintained, Begin hashes the entries
+    sizes[plan->length] = size;
+    plan->length++;
+    plan_count(plan, size);
+}
+
 RGLAYOUTAPI RGLPlan GuiPlanCreate(const float *sizes, int length)
 {
     RGLPlan plan = {0};
     plan.length = 0;
+    plan.hash = RGL__PLAN_SEED;
     plan.gap = 0;
     plan.pad = (RGLPad){0, 0, 0, 0};
     plan.has_gap = false;
@@ -615,32 +4892,61 @@ RGLAYOUTAPI RGLPlan GuiPlanCreate(const float *sizes, int length)
     {
         for (int i = 0; i < length; i++)
         {
-            plan.sizes[i] = sizes[i];
+            plan_push(&plan, sizes[i]);
         }
-        plan.length = length;
     }
 
     return plan;
 }
 
-RGLAYOUTAPI void GuiPlanAdd(RGLPlan *plan, float size)
+RGLAYOUTAPI RGLPlan GuiPlanCreateBuffer(float *buffer, int capacity)
+{
+    RGLPlan plan = GuiPlanCreate(NULL, 0);
+
+    if (buffer != NULL && capacity > 0)
+    {
+        plan.entries = buffer;
+        plan.capacity = capacity;
+    }
+
+    return plan;
+}
+
+RGLAYOUTAPI RGLPlan GuiPlanCreateArena(RGLArena *arena, int capacity)
 {
-    if (plan != NULL && plan->length < RGL_PLAN_MAX)
+    RGLPlan plan = GuiPlanCreate(NULL, 0);
+    if (capacity < 1)
+        capacity = RGL_PLAN_MAX;
+
+    float *block = (float *)RGLArenaAlloc(arena, (size_t)capacity * sizeof(float));
+    if (block != NULL)
     {
-        plan->sizes[plan->length] = size;
-        plan->length++;
+        plan.entries = block;
+        plan.capacity = capacity;
+        plan.arena = arena;
     }
+
+    return plan;
+}
+
+RGLAYOUTAPI void GuiPlanAdd(RGLPlan *plan, float size)
+{
+    if (plan != NULL)
+        plan_push(plan, size);
 }
 
 RGLAYOUTAPI void GuiPlanAddRepeat(RGLPlan *plan, float size, int count)
 {
+    if (plan == NULL || count <= 0)
+        return;
+
+    // One growth step for the whole run
+    if (plan->entries != NULL && plan->length + count > plan->capacity)
+        plan_grow(plan, plan->length + count);
+
     for (int i = 0; i < count; i++)
     {
-        if (plan != NULL && plan->length < RGL_PLAN_MAX)
-        {
-            plan->sizes[plan->length] = size;
-            plan->length++;
-        }
+        plan_push(plan, size);
     }
 }
 
@@ -672,4 +4978,10 @@ RGLAYOUTAPI void GuiPlanSetPadAll(RGLPlan *plan, float pad)
     }
 }
 
+RGLAYOUTAPI void GuiPlanRefresh(RGLPlan *plan)
+{
+    if (plan != NULL)
+        plan_refresh(plan);
+}
+
 #endif // RGLAYOUT_IMPLEMENTATION
@@ -0,0 +1,175 @@
+// Golden rect test
+//
+// Lays out the example programs at a few window sizes and compares every
+// rect with tests/golden/<layout>.txt. The files list one rect per line
+// ("x y width height", %.9g so floats round-trip exactly), in a block per
+// window size. Any difference fails: layout results must not change unless
+// the change is intended, in which case the files are regenerated.
+//
+// Usage: rglayout-test-golden <golden dir> [--update]
+
+#define RGLAYOUT_STANDALONE
+#define RGLAYOUT_IMPLEMENTATION
+#include "rglayout.h"
+#include "test_layouts.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define GOLDEN_MAX_RECTS 64
+
+typedef struct GoldenRects
+{
+    Rectangle rects[GOLDEN_MAX_RECTS];
+    int count;
+} GoldenRects;
+
+static void golden_emit(Rectangle rect, void *user)
+{
+    GoldenRects *out = (GoldenRects *)user;
+    if (out->count < GOLDEN_MAX_RECTS) out->rects[out->count] = rect;
+    out->count++;
+}
+
+static void golden_run(const TestLayout *layout, Rectangle screen, GoldenRects *out)
+{
+    RGLContext ctx;
+    RGLInitContext(&ctx);
+    RGLBeginFrameCtx(&ctx);
+    out->count = 0;
+    layout->run(&ctx, screen, golden_emit, out);
+}
+
+static bool golden_write(const char *path, const TestLayout *layout)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "# %s: x y width height per rect, one block per window size\n", layout->name);
+    for (int s = 0; s < 3; s++)
+    {
+        GoldenRects out;
+        golden_run(layout, layout->sizes[s], &out);
+        fprintf(file, "size %.9g %.9g\n", layout->sizes[s].width, layout->sizes[s].height);
+        for (int i = 0; i < out.count; i++)
+        {
+            Rectangle r = out.rects[i];
+            fprintf(file, "%.9g %.9g %.9g %.9g\n", r.x, r.y, r.width, r.height);
+        }
+    }
+    return fclose(file) == 0;
+}
+
+// Returns the number of differences (a missing or malformed file counts as one)
+static int golden_check(const char *path, const TestLayout *layout)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s: cannot open (run with --update to create it)\n", path);
+        return 1;
+    }
+
+    int failures = 0;
+    char line[256];
+    int line_number = 0;
+    int size_index = -1;
+    int rect_index = 0;
+    GoldenRects out = { 0 };
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        line_number++;
+        float a, b, c, d;
+        if (line[0] == '#' || line[0] == '\n') continue;
+
+        if (sscanf(line, "size %f %f", &a, &b) == 2)
+        {
+            if (size_index >= 0 && rect_index != out.count)
+            {
+                fprintf(stderr, "%s:%d: %d rects expected, layout produced %d\n", path, line_number, rect_index, out.count);
+                failures++;
+            }
+            size_index++;
+            if (size_index >= 3 || a != layout->sizes[size_index].width || b != layout->sizes[size_index].height)
+            {
+                fprintf(stderr, "%s:%d: unexpected window size %.9g x %.9g\n", path, line_number, a, b);
+                fclose(file);
+                return failures + 1;
+            }
+            golden_run(layout, layout->sizes[size_index], &out);
+            rect_index = 0;
+            continue;
+        }
+
+        if (size_index < 0 || sscanf(line, "%f %f %f %f", &a, &b, &c, &d) != 4)
+        {
+            fprintf(stderr, "%s:%d: malformed line\n", path, line_number);
+            fclose(file);
+            return failures + 1;
+        }
+
+        if (rect_index >= out.count)
+        {
+            fprintf(stderr, "%s:%d: layout produced only %d rects\n", path, line_number, out.count);
+            failures++;
+        }
+        else
+        {
+            Rectangle r = out.rects[rect_index];
+            if (r.x != a || r.y != b || r.width != c || r.height != d)
+            {
+                fprintf(stderr, "%s:%d: rect %d is {%.9g, %.9g, %.9g, %.9g}, expected {%.9g, %.9g, %.9g, %.9g}\n",
+                    path, line_number, rect_index, r.x, r.y, r.width, r.height, a, b, c, d);
+                failures++;
+            }
+        }
+        rect_index++;
+    }
+    fclose(file);
+
+    if (size_index != 2)
+    {
+        fprintf(stderr, "%s: %d window sizes expected, found %d\n", path, 3, size_index + 1);
+        failures++;
+    }
+    else if (rect_index != out.count)
+    {
+        fprintf(stderr, "%s: %d rects expected in the last block, layout produced %d\n", path, rect_index, out.count);
+        failures++;
+    }
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <golden dir> [--update]\n", argv[0]);
+        return 2;
+    }
+    bool update = (argc > 2) && (strcmp(argv[2], "--update") == 0);
+
+    int failures = 0;
+    for (int i = 0; i < TEST_LAYOUT_COUNT; i++)
+    {
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s.txt", argv[1], TEST_LAYOUTS[i].name);
+
+        if (update)
+        {
+            if (!golden_write(path, &TEST_LAYOUTS[i]))
+            {
+                fprintf(stderr, "%s: cannot write\n", path);
+                failures++;
+            }
+            continue;
+        }
+
+        int differences = golden_check(path, &TEST_LAYOUTS[i]);
+        printf("%s: %s\n", TEST_LAYOUTS[i].name, (differences == 0)? "ok" : "FAILED");
+        failures += differences;
+    }
+
+    return (failures == 0)? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// Layouts of the example programs, without raygui (RGLAYOUT_STANDALONE)
+//
+// Each function lays out one frame of the matching examples/*.c demo in ctx
+// and passes every rect the demo draws (or takes as a spacer) to emit, in
+// call order. Shared by the golden and perf tests.
+
+#ifndef RGLAYOUT_TEST_LAYOUTS_H
+#define RGLAYOUT_TEST_LAYOUTS_H
+
+typedef void (*TestEmitFunc)(Rectangle rect, void *user);
+
+typedef struct TestLayout
+{
+    const char *name;
+    void (*run)(RGLContext *ctx, Rectangle screen, TestEmitFunc emit, void *user);
+    Rectangle sizes[3]; // Window sizes checked by the golden test (first: the demo's initial size)
+} TestLayout;
+
+// examples/3panel.c
+static void layout_3panel(RGLContext *ctx, Rectangle screen, TestEmitFunc emit, void *user)
+{
+    RGLSetDefaultGapCtx(ctx, 10.0f);
+    RGLSetDefaultPadAllCtx(ctx, 0.0f);
+
+    RGLPlan column_plan = GuiPlanCreate((float[]){50, -1}, 2);
+    GuiPlanSetPadAll(&column_plan, 10);
+    GuiBeginColumnCtx(ctx, screen, &column_plan);
+
+        emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Header
+
+        RGL_PLAN_DEFINE(content_plan, 1, 3, 1);
+        GuiBeginRowCtx(ctx, GuiLayoutRecCtx(ctx, -1, -1), &content_plan);
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Left sidebar
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Center content
+            emit(GuiLayoutRecCtx(ctx, 50, -1), user); // Right sidebar
+        GuiLayoutEndCtx(ctx);
+
+    GuiLayoutEndCtx(ctx);
+}
+
+// examples/nested.c
+static void layout_nested(RGLContext *ctx, Rectangle screen, TestEmitFunc emit, void *user)
+{
+    RGLSetDefaultGapCtx(ctx, 5.0f);
+    RGLSetDefaultPadAllCtx(ctx, 0.0f);
+
+    RGLPlan column_plan = GuiPlanCreate((float[]){50, -1}, 2);
+    GuiPlanSetPadAll(&column_plan, 10);
+    GuiBeginColumnCtx(ctx, screen, &column_plan);
+
+        RGL_PLAN_DEFINE(header_plan, 1, 4);
+        GuiBeginRowCtx(ctx, GuiLayoutRecCtx(ctx, -1, -1), &header_plan);
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Logo
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Header
+        GuiLayoutEndCtx(ctx);
+
+        RGL_PLAN_DEFINE(content_plan, 1, 3, 1);
+        GuiBeginRowCtx(ctx, GuiLayoutRecCtx(ctx, -1, -1), &content_plan);
+
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Left sidebar
+
+            GuiBeginColumnCtx(ctx, GuiLayoutRecCtx(ctx, -1, -1), NULL);
+
+                Rectangle tb_rect = GuiLayoutRecCtx(ctx, 60, -1);
+                GuiBeginRowCtx(ctx, tb_rect, NULL);
+                    emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Toolbar
+                GuiLayoutEndCtx(ctx);
+
+                RGLPlan toolbar_plan = GuiPlanCreate(NULL, 0);
+                GuiPlanAdd(&toolbar_plan, -1);
+                GuiPlanAddRepeat(&toolbar_plan, 40, 10);
+                GuiPlanSetPadAll(&toolbar_plan, 10);
+                GuiBeginRowCtx(ctx, tb_rect, &toolbar_plan);
+                    emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Nested toolbar
+                    for (int i = 0; i < 10; i++) emit(GuiLayoutRecCtx(ctx, -1, -1), user);
+                GuiLayoutEndCtx(ctx);
+
+                GuiBeginRowCtx(ctx, GuiLayoutRecCtx(ctx, -1, -1), NULL);
+                    RGL_PLAN_DEFINE(main_plan, -1, 50);
+                    GuiBeginColumnCtx(ctx, GuiLayoutRecCtx(ctx, -1, -1), &main_plan);
+                        emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Content
+                        emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Footer
+                    GuiLayoutEndCtx(ctx);
+                GuiLayoutEndCtx(ctx);
+
+            GuiLayoutEndCtx(ctx);
+
+            RGLPlan sidebar_plan = GuiPlanCreate((float[]){-1, 100, 50}, 3);
+            GuiPlanSetPadAll(&sidebar_plan, 10);
+            GuiBeginColumnCtx(ctx, GuiLayoutRecCtx(ctx, -1, -1), &sidebar_plan);
+                emit(GuiLayoutRecLastCtx(ctx), user);           // Right sidebar (reused rect)
+                emit(GuiLayoutRecCtx(ctx, -1, -1), user);      // Sidebar nested
+                emit(GuiLayoutRecCtx(ctx, 100, 100), user);    // Custom size
+                emit(GuiLayoutRecCtx(ctx, -1, -1), user);      // Nested footer
+            GuiLayoutEndCtx(ctx);
+
+        GuiLayoutEndCtx(ctx);
+
+    GuiLayoutEndCtx(ctx);
+}
+
+// examples/form.c
+static void layout_form(RGLContext *ctx, Rectangle screen, TestEmitFunc emit, void *user)
+{
+    RGLSetDefaultGapCtx(ctx, 10.0f);
+
+    RGLSetDefaultPadAllCtx(ctx, 10);
+    GuiBeginColumnCtx(ctx, screen, NULL);
+    RGLSetDefaultPadAllCtx(ctx, 0);
+
+        GuiBeginRowCtx(ctx, GuiLayoutRecCtx(ctx, 50, -1), NULL);
+            emit(GuiLayoutRecCtx(ctx, 75, -1), user); // Username label
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Username text box
+        GuiLayoutEndCtx(ctx);
+
+        GuiBeginRowCtx(ctx, GuiLayoutRecCtx(ctx, 50, -1), NULL);
+            emit(GuiLayoutRecCtx(ctx, 75, -1), user); // Password label
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Password text box
+        GuiLayoutEndCtx(ctx);
+
+        RGL_PLAN_DEFINE(login_row_plan, -1, 100, -1);
+        GuiBeginRowCtx(ctx, GuiLayoutRecCtx(ctx, 50, -1), &login_row_plan);
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Space
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Login button
+            emit(GuiLayoutRecCtx(ctx, -1, -1), user); // Space
+        GuiLayoutEndCtx(ctx);
+
+    GuiLayoutEndCtx(ctx);
+}
+
+static const TestLayout TEST_LAYOUTS[] = {
+    { "3panel", layout_3panel, { { 0, 0, 720, 480 }, { 0, 0, 1920, 1080 }, { 0, 0, 120, 90 } } },
+    { "nested", layout_nested, { { 0, 0, 1024, 512 }, { 0, 0, 1920, 1080 }, { 0, 0, 300, 200 } } },
+    { "form", layout_form, { { 0, 0, 300, 200 }, { 0, 0, 800, 600 }, { 0, 0, 90, 60 } } },
+};
+
+#define TEST_LAYOUT_COUNT (int)(sizeof(TEST_LAYOUTS)/sizeof(TEST_LAYOUTS[0]))
+
+#endif // RGLAYOUT_TEST_LAYOUTS_H
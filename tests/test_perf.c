@@ -0,0 +1,214 @@
+// Layout performance regression check
+//
+// Times a few layouts (the example programs plus wide planned and ad-hoc
+// rows) and compares ns per rect with tests/perf_baseline.txt. A layout
+// fails when it is slower than baseline*tolerance. The default tolerance is
+// 3.0, set RGLAYOUT_PERF_TOLERANCE to override it. Each layout keeps the
+// best of several runs, so a busy machine rarely trips the check.
+//
+// Baselines are machine specific: regenerate them with --update on the
+// machine that runs the tests. Exits with 77 (skipped) without a baseline.
+//
+// Usage: rglayout-test-perf <baseline file> [--update]
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L // Required for: clock_gettime()
+#endif
+
+#define RGLAYOUT_STANDALONE
+#define RGLAYOUT_IMPLEMENTATION
+#include "rglayout.h"
+#include "test_layouts.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+// Avoid windows.h, it conflicts with raylib-style names (Rectangle, CloseWindow...)
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *freq);
+#else
+#include <time.h>
+#endif
+
+#define PERF_RUNS 7
+#define PERF_RUN_NS 20e6 // Target duration of one run
+#define PERF_SKIP 77     // CTest SKIP_RETURN_CODE
+
+static double perf_now_ns(void)
+{
+#if defined(_WIN32)
+    long long count = 0, freq = 1;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (double)count*1e9/(double)freq;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec*1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+// Accumulated over every produced rect so the optimizer can't drop layout work
+static double g_checksum = 0.0;
+static long g_rects = 0;
+
+static void perf_emit(Rectangle r, void *user)
+{
+    (void)user;
+    g_checksum += r.x + r.y + r.width + r.height;
+    g_rects++;
+}
+
+static void layout_wide_plan(RGLContext *ctx, Rectangle screen, TestEmitFunc emit, void *user)
+{
+    RGL_PLAN_DEFINE(plan, -1, 40, 2, 60, -1, 40, 2, 60, -1, 40, 2, 60, -1, 40, 2, 60,
+                          -1, 40, 2, 60, -1, 40, 2, 60, -1, 40, 2, 60, -1, 40, 2, 60);
+    GuiBeginColumnCtx(ctx, screen, NULL);
+    for (int row = 0; row < 16; row++)
+    {
+        GuiBeginRowCtx(ctx, GuiLayoutRecCtx(ctx, 30, -1), &plan);
+        for (int i = 0; i < RGL_PLAN_MAX; i++) emit(GuiLayoutRecCtx(ctx, -1, -1), user);
+        GuiLayoutEndCtx(ctx);
+    }
+    GuiLayoutEndCtx(ctx);
+}
+
+static void layout_adhoc(RGLContext *ctx, Rectangle screen, TestEmitFunc emit, void *user)
+{
+    GuiBeginColumnCtx(ctx, screen, NULL);
+    for (int row = 0; row < 16; row++)
+    {
+        GuiBeginRowCtx(ctx, GuiLayoutRecCtx(ctx, 30, -1), NULL);
+        for (int i = 0; i < 32; i++) emit(GuiLayoutRecCtx(ctx, (i%4 == 3)? -1 : 20, -1), user);
+        GuiLayoutEndCtx(ctx);
+    }
+    GuiLayoutEndCtx(ctx);
+}
+
+static const TestLayout PERF_LAYOUTS[] = {
+    { "wide_plan", layout_wide_plan, { { 0, 0, 1920, 1080 } } },
+    { "adhoc", layout_adhoc, { { 0, 0, 1920, 1080 } } },
+};
+
+#define PERF_LAYOUT_COUNT (TEST_LAYOUT_COUNT + (int)(sizeof(PERF_LAYOUTS)/sizeof(PERF_LAYOUTS[0])))
+
+static const TestLayout *perf_layout(int i)
+{
+    return (i < TEST_LAYOUT_COUNT)? &TEST_LAYOUTS[i] : &PERF_LAYOUTS[i - TEST_LAYOUT_COUNT];
+}
+
+// Best ns per rect over PERF_RUNS runs of about PERF_RUN_NS each
+static double perf_measure(const TestLayout *layout)
+{
+    RGLContext ctx;
+    RGLInitContext(&ctx);
+    Rectangle screen = layout->sizes[0];
+
+    // Calibrate the frame count of one run
+    long frames = 1;
+    for (;;)
+    {
+        double start = perf_now_ns();
+        for (long f = 0; f < frames; f++)
+        {
+            RGLBeginFrameCtx(&ctx);
+            layout->run(&ctx, screen, perf_emit, NULL);
+        }
+        if (perf_now_ns() - start >= PERF_RUN_NS/4 || frames >= (1L << 26)) break;
+        frames *= 2;
+    }
+    frames *= 4;
+
+    double best = 0;
+    for (int run = 0; run < PERF_RUNS; run++)
+    {
+        g_rects = 0;
+        double start = perf_now_ns();
+        for (long f = 0; f < frames; f++)
+        {
+            RGLBeginFrameCtx(&ctx);
+            layout->run(&ctx, screen, perf_emit, NULL);
+        }
+        double ns_per_rect = (perf_now_ns() - start)/(double)g_rects;
+        if (run == 0 || ns_per_rect < best) best = ns_per_rect;
+    }
+    return best;
+}
+
+// Baseline of a layout (< 0: not listed)
+static double perf_baseline(FILE *file, const char *name)
+{
+    char line[256], key[64];
+    double value;
+
+    rewind(file);
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%63s %lf", key, &value) == 2 && strcmp(key, name) == 0) return value;
+    }
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <baseline file> [--update]\n", argv[0]);
+        return 2;
+    }
+    bool update = (argc > 2) && (strcmp(argv[2], "--update") == 0);
+
+    double tolerance = 3.0;
+    const char *env = getenv("RGLAYOUT_PERF_TOLERANCE");
+    if (env != NULL && atof(env) > 0) tolerance = atof(env);
+
+    if (update)
+    {
+        FILE *file = fopen(argv[1], "w");
+        if (file == NULL)
+        {
+            fprintf(stderr, "%s: cannot write\n", argv[1]);
+            return 1;
+        }
+        fprintf(file, "# Best ns per rect (rglayout-test-perf --update), machine specific\n");
+        for (int i = 0; i < PERF_LAYOUT_COUNT; i++)
+            fprintf(file, "%s %.3f\n", perf_layout(i)->name, perf_measure(perf_layout(i)));
+        return (fclose(file) == 0)? 0 : 1;
+    }
+
+    FILE *file = fopen(argv[1], "r");
+    if (file == NULL)
+    {
+        printf("%s: no baseline, skipped (run with --update to create it)\n", argv[1]);
+        return PERF_SKIP;
+    }
+
+    int failures = 0;
+    printf("layout,ns_per_rect,baseline,limit\n");
+    for (int i = 0; i < PERF_LAYOUT_COUNT; i++)
+    {
+        const TestLayout *layout = perf_layout(i);
+        double baseline = perf_baseline(file, layout->name);
+        double measured = perf_measure(layout);
+
+        if (baseline <= 0)
+        {
+            printf("%s,%.3f,none,none\n", layout->name, measured);
+            continue;
+        }
+        printf("%s,%.3f,%.3f,%.3f\n", layout->name, measured, baseline, baseline*tolerance);
+        if (measured > baseline*tolerance)
+        {
+            fprintf(stderr, "%s: %.3f ns/rect exceeds %.3f (baseline %.3f x %.2f)\n",
+                layout->name, measured, baseline*tolerance, baseline, tolerance);
+            failures++;
+        }
+    }
+    fclose(file);
+
+    if (g_checksum == 0.0) printf("checksum: %f\n", g_checksum); // Keep the layout work observable
+    return (failures == 0)? 0 : 1;
+}
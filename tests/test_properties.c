@@ -0,0 +1,842 @@
+// Randomized layout properties
+//
+// Builds random container trees from fixed seeds and checks invariants that
+// must hold for any input:
+//
+//   containment  every non-empty child rect lies inside its container's inner
+//                rect (plans whose fixed sizes and gaps fit, children within
+//                the plan, non-negative padding)
+//   flex sums    the flex children of a plan share exactly the space left
+//                after the fixed entries and the gaps
+//   balance      the stack depth follows Begin/End, skipped containers
+//                included, and unbalanced frames are reported
+//   item ids     every item of a flow gets its own ID across lines, and a
+//                scroll item keeps its ID at any scroll offset, and a
+//                container skipped for span overflow shifts no sibling ID
+//   replay       a recorded frame replays on a fresh context (library
+//                defaults) with every rect identical
+//   resize       an incremental tree solve at new bounds gives the same
+//                rects as a full solve
+//   breakpoints  a cached responsive container lays out like a plain one
+//                opened with the plan its width selects
+//   hand plans   a plan filled by hand (no builder) lays out like a built
+//                one, and GuiPlanRefresh() matches an edited plan to a rebuild
+//   plan reuse   a plan emptied (length = 0) and rebuilt every frame lays
+//                out like a freshly created one
+//   cache        cached containers (IDs reused while open, plans edited
+//                between frames) lay out like uncached ones
+//
+// Usage: rglayout-test-properties [seeds]
+
+#define RGLAYOUT_STANDALONE
+#define RGLAYOUT_ENABLE_RECORD
+#define RGLAYOUT_IMPLEMENTATION
+#include "rglayout.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_failures = 0;
+static unsigned int g_seed = 0;
+
+#define CHECK(cond, ...) do { if (!(cond)) { \
+    if (g_failures++ < 20) { fprintf(stderr, "%s:%d: seed %u: ", __FILE__, __LINE__, g_seed); \
+    fprintf(stderr, __VA_ARGS__); fputc('\n', stderr); } } } while (0)
+
+//----------------------------------------------------------------------------------
+// Random input
+//----------------------------------------------------------------------------------
+
+static unsigned int g_rng = 1;
+
+static unsigned int rng_next(void)
+{
+    // xorshift32
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+static int rng_int(int lo, int hi) // [lo, hi]
+{
+    return lo + (int)(rng_next()%(unsigned int)(hi - lo + 1));
+}
+
+static float rng_float(float lo, float hi)
+{
+    return lo + (hi - lo)*(float)(rng_next() & 0xffffff)/(float)0xffffff;
+}
+
+//----------------------------------------------------------------------------------
+// Geometry
+//----------------------------------------------------------------------------------
+
+static float tolerance(Rectangle r)
+{
+    float extent = fabsf(r.x) + fabsf(r.y) + r.width + r.height;
+    return 1e-4f*((extent > 1)? extent : 1);
+}
+
+static bool rect_inside(Rectangle child, Rectangle inner)
+{
+    float eps = tolerance(inner);
+    return child.x >= inner.x - eps && child.y >= inner.y - eps &&
+        child.x + child.width <= inner.x + inner.width + eps &&
+        child.y + child.height <= inner.y + inner.height + eps;
+}
+
+static Rectangle inner_rect(Rectangle bounds, RGLPad pad)
+{
+    Rectangle r = { bounds.x + pad.left, bounds.y + pad.top,
+        bounds.width - pad.left - pad.right, bounds.height - pad.top - pad.bottom };
+    if (r.width < 0) r.width = 0;
+    if (r.height < 0) r.height = 0;
+    return r;
+}
+
+static void check_child(Rectangle child, Rectangle inner, const char *kind, int depth)
+{
+    if (child.width <= 0 || child.height <= 0) return; // Empty rects cover nothing
+    CHECK(rect_inside(child, inner), "%s child {%g, %g, %g, %g} at depth %d leaves inner {%g, %g, %g, %g}",
+        kind, child.x, child.y, child.width, child.height, depth, inner.x, inner.y, inner.width, inner.height);
+}
+
+//----------------------------------------------------------------------------------
+// Random plans
+//----------------------------------------------------------------------------------
+
+static bool is_flex(float v)
+{
+    return v == -1 || (v > 0 && v < 20);
+}
+
+// Random plan whose fixed entries and gaps fit in 'available' (flex entries share the rest)
+static RGLPlan random_plan(int length, float available, float gap)
+{
+    RGLPlan plan = GuiPlanCreate(NULL, 0);
+    float budget = available - gap*(float)(length - 1);
+
+    for (int i = 0; i < length; i++)
+    {
+        float v;
+        int kind = rng_int(0, 9);
+        if (kind < 3) v = -1;
+        else if (kind < 6) v = (float)rng_int(1, 19);
+        else if (kind < 9) v = (float)rng_int(20, 120);
+        else v = 0;
+
+        if (v >= 20 && v > budget) v = -1; // Keep the plan feasible
+        if (v >= 20) budget -= v;
+        GuiPlanAdd(&plan, v);
+    }
+    return plan;
+}
+
+//----------------------------------------------------------------------------------
+// Containment and flex sums
+//----------------------------------------------------------------------------------
+
+static void random_container(RGLContext *ctx, Rectangle bounds, int depth);
+
+// A child of a row/column: a plain rect, a padded/aligned rect or a nested container
+static Rectangle random_child(RGLContext *ctx, float main, Rectangle inner, int depth)
+{
+    float cross = (rng_int(0, 2) == 0)? -1 : rng_float(0, 300);
+    Rectangle r;
+
+    if (rng_int(0, 3) == 0)
+    {
+        float pl = rng_float(0, 8), pr = rng_float(0, 8), pt = rng_float(0, 8), pb = rng_float(0, 8);
+        r = GuiLayoutRecExCtx(ctx, main, cross, pl, pr, pt, pb, (RGLVAlign)rng_int(0, 3));
+    }
+    else
+    {
+        r = GuiLayoutRecAlignCtx(ctx, main, cross, (RGLVAlign)rng_int(0, 3));
+    }
+    check_child(r, inner, "row/column", depth);
+
+    if (depth < 6 && rng_int(0, 4) == 0) random_container(ctx, r, depth + 1);
+    return r;
+}
+
+static void random_linear(RGLContext *ctx, Rectangle bounds, RGLAxis axis, RGLPad pad, float gap, int depth)
+{
+    Rectangle inner = inner_rect(bounds, pad);
+    float available = (axis == RGL_AXIS_ROW)? inner.width : inner.height;
+    int length = rng_int(1, RGL_PLAN_MAX);
+    bool planned = rng_int(0, 2) > 0 && available >= gap*(float)(length - 1);
+
+    if (!planned)
+    {
+        if (axis == RGL_AXIS_ROW) GuiBeginRowExCtx(ctx, bounds, pad, gap, NULL);
+        else GuiBeginColumnExCtx(ctx, bounds, pad, gap, NULL);
+
+        int count = rng_int(0, 12);
+        for (int i = 0; i < count; i++)
+            random_child(ctx, (rng_int(0, 3) == 0)? -1 : rng_float(0, 200), inner, depth);
+        GuiLayoutEndCtx(ctx);
+        return;
+    }
+
+    RGLPlan plan = random_plan(length, available, gap);
+    if (axis == RGL_AXIS_ROW) GuiBeginRowExCtx(ctx, bounds, pad, gap, &plan);
+    else GuiBeginColumnExCtx(ctx, bounds, pad, gap, &plan);
+
+    // Flex sum: planned spans of flex entries fill what the fixed entries and gaps leave
+    Rectangle planned_rects[RGL_PLAN_MAX];
+    int planned_count = GuiLayoutPlanRecsCtx(ctx, planned_rects, RGL_PLAN_MAX);
+    CHECK(planned_count == length, "GuiLayoutPlanRecs returned %d of %d", planned_count, length);
+
+    float flex = 0, fixed = 0;
+    bool any_flex = false;
+    for (int i = 0; i < length; i++)
+    {
+        float size = (axis == RGL_AXIS_ROW)? planned_rects[i].width : planned_rects[i].height;
+        if (is_flex(plan.sizes[i])) { flex += size; any_flex = true; }
+        else if (plan.sizes[i] >= 20) fixed += size;
+    }
+    float gaps = gap*(float)(length - 1);
+    float expected = available - plan.sum_fixed - gaps;
+    float eps = 1e-4f*(available + 1);
+    CHECK(fabsf(fixed - plan.sum_fixed) <= eps, "fixed entries got %g of %g", fixed, plan.sum_fixed);
+    if (any_flex)
+        CHECK(fabsf(flex - expected) <= eps, "flex entries got %g, expected %g (available %g, fixed %g, gaps %g)",
+            flex, expected, available, plan.sum_fixed, gaps);
+
+    // Children within the plan, each matching its planned span
+    int count = rng_int(0, length);
+    for (int i = 0; i < count; i++)
+    {
+        Rectangle r = GuiLayoutRecCtx(ctx, -1, -1);
+        Rectangle p = planned_rects[i];
+        CHECK(r.x == p.x && r.y == p.y && r.width == p.width && r.height == p.height,
+            "planned child %d {%g, %g, %g, %g} differs from GuiLayoutPlanRecs {%g, %g, %g, %g}",
+            i, r.x, r.y, r.width, r.height, p.x, p.y, p.width, p.height);
+        check_child(r, inner, "planned", depth);
+        if (depth < 6 && rng_int(0, 4) == 0) random_container(ctx, r, depth + 1);
+    }
+    GuiLayoutEndCtx(ctx);
+}
+
+static void random_grid(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, int depth)
+{
+    Rectangle inner = inner_rect(bounds, pad);
+    int columns = rng_int(1, 6), rows = rng_int(1, 6);
+    if (inner.width < gap*(float)(columns - 1) || inner.height < gap*(float)(rows - 1))
+        return;
+
+    RGLPlan col_plan = random_plan(columns, inner.width, gap);
+    RGLPlan row_plan = random_plan(rows, inner.height, gap);
+    GuiBeginGridExCtx(ctx, bounds, pad, gap, &col_plan, &row_plan);
+
+    for (int i = 0; i < rows*columns; i++)
+    {
+        Rectangle r = GuiLayoutRecCtx(ctx, -1, -1);
+        check_child(r, inner, "grid", depth);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        Rectangle r = GuiLayoutCellSpanCtx(ctx, rng_int(0, rows - 1), rng_int(0, columns - 1), rng_int(1, rows), rng_int(1, columns));
+        check_child(r, inner, "grid span", depth);
+        if (depth < 6 && rng_int(0, 6) == 0) random_container(ctx, r, depth + 1);
+    }
+    GuiLayoutEndCtx(ctx);
+}
+
+static void random_flow(RGLContext *ctx, Rectangle bounds, RGLPad pad, float gap, int depth)
+{
+    Rectangle inner = inner_rect(bounds, pad);
+    GuiBeginFlowExCtx(ctx, bounds, pad, gap, rng_float(0, 40));
+
+    // Items may extend past the bottom, but never past the sides or above the top
+    float eps = tolerance(inner);
+    int count = rng_int(0, 30);
+    for (int i = 0; i < count; i++)
+    {
+        Rectangle r = GuiLayoutRecCtx(ctx, (rng_int(0, 5) == 0)? -1 : rng_float(0, 150), rng_float(-1, 40));
+        if (r.width <= 0 || r.height <= 0) continue;
+        CHECK(r.x >= inner.x - eps && r.x + r.width <= inner.x + inner.width + eps && r.y >= inner.y - eps,
+            "flow child {%g, %g, %g, %g} at depth %d leaves inner {%g, %g, %g, %g}",
+            r.x, r.y, r.width, r.height, depth, inner.x, inner.y, inner.width, inner.height);
+    }
+    GuiLayoutEndCtx(ctx);
+}
+
+static void random_container(RGLContext *ctx, Rectangle bounds, int depth)
+{
+    RGLPad pad = { rng_float(0, 12), rng_float(0, 12), rng_float(0, 12), rng_float(0, 12) };
+    float gap = (rng_int(0, 3) == 0)? 0 : rng_float(0, 12);
+
+    int kind = rng_int(0, 9);
+    if (kind < 4) random_linear(ctx, bounds, RGL_AXIS_ROW, pad, gap, depth);
+    else if (kind < 8) random_linear(ctx, bounds, RGL_AXIS_COLUMN, pad, gap, depth);
+    else if (kind < 9) random_grid(ctx, bounds, pad, gap, depth);
+    else random_flow(ctx, bounds, pad, gap, depth);
+}
+
+static void test_layout_properties(RGLContext *ctx)
+{
+    Rectangle screen = { rng_float(-500, 500), rng_float(-500, 500), rng_float(0, 2500), rng_float(0, 1500) };
+
+    RGLBeginFrameCtx(ctx);
+    for (int i = 0; i < 4; i++) random_container(ctx, screen, 0);
+    CHECK(ctx->state.top == 0, "stack depth %d after a balanced frame", ctx->state.top);
+}
+
+//----------------------------------------------------------------------------------
+// Push/pop balance
+//----------------------------------------------------------------------------------
+
+static void test_balance(RGLContext *ctx, bool growable)
+{
+    Rectangle screen = { 0, 0, 800, 600 };
+    int depth = 0, peak = 0;
+    bool extra_end = false;
+
+    RGLBeginFrameCtx(ctx);
+    int ops = rng_int(0, 200);
+    for (int i = 0; i < ops; i++)
+    {
+        if (rng_int(0, 9) < 6 && depth < 48)
+        {
+            switch (rng_int(0, 3))
+            {
+            case 0: GuiBeginRowCtx(ctx, screen, NULL); break;
+            case 1: GuiBeginColumnCtx(ctx, screen, RGL_PLAN(-1, 40, 2)); break;
+            case 2: GuiBeginGridCtx(ctx, screen, RGL_PLAN(-1, -1), NULL); break;
+            default: GuiBeginScrollColumnCtx(ctx, screen, 10, 100, 20); break;
+            }
+            depth++;
+            if (depth > peak) peak = depth;
+        }
+        else
+        {
+            GuiLayoutEndCtx(ctx);
+            if (depth > 0) depth--;
+            else extra_end = true;
+        }
+        GuiLayoutRecCtx(ctx, 20, -1);
+
+        RGLState *st = &ctx->state;
+        CHECK(st->top + st->overflow_depth == depth, "depth %d + skipped %d after op %d, expected %d",
+            st->top, st->overflow_depth, i, depth);
+    }
+
+    // Without growth, nesting past RGL_MAX_STACK (or the inline spans) skips containers
+    int errors = RGLGetErrorsCtx(ctx);
+    bool skipped = (errors & (RGL_ERROR_STACK_OVERFLOW | RGL_ERROR_SPAN_OVERFLOW)) != 0;
+    if (growable)
+        CHECK(!skipped, "containers skipped with an arena (peak depth %d)", peak);
+    else
+        CHECK(!skipped || peak > RGL_MAX_STACK, "containers skipped at peak depth %d", peak);
+    CHECK(((errors & RGL_ERROR_UNBALANCED) != 0) == extra_end, "unbalanced flag %d after an extra End: %d",
+        (errors & RGL_ERROR_UNBALANCED) != 0, extra_end);
+
+    // Containers left open are reported by the next frame, which starts from an empty stack
+    RGLBeginFrameCtx(ctx);
+    CHECK(((RGLGetErrorsCtx(ctx) & RGL_ERROR_UNBALANCED) != 0) == (depth != 0), "open containers (%d) not reported", depth);
+    CHECK(ctx->state.top == 0 && ctx->state.overflow_depth == 0, "stack not empty after RGLBeginFrame");
+}
+
+//----------------------------------------------------------------------------------
+// Item IDs
+//----------------------------------------------------------------------------------
+
+#define ID_ITEMS 64
+
+static void test_item_ids(RGLContext *ctx)
+{
+    unsigned int ids[ID_ITEMS];
+
+    // Flow: items on later lines must not reuse the IDs of earlier lines
+    int count = rng_int(1, ID_ITEMS);
+    RGLBeginFrameCtx(ctx);
+    GuiBeginFlowCtx(ctx, (Rectangle){ 0, 0, rng_float(20, 300), 2000 }, 20);
+    for (int i = 0; i < count; i++)
+    {
+        GuiLayoutRecCtx(ctx, (rng_int(0, 5) == 0)? -1 : rng_float(0, 120), -1);
+        ids[i] = GuiLayoutIdLastCtx(ctx);
+        for (int j = 0; j < i; j++) CHECK(ids[i] != ids[j], "flow items %d and %d share ID 0x%08x", j, i, ids[i]);
+    }
+    GuiLayoutEndCtx(ctx);
+
+    // Scroll: IDs of every item with all of them visible, then of the visible ones at a random offset
+    float item_size = rng_float(1, 40), gap = 2;
+    RGLBeginFrameCtx(ctx);
+    GuiBeginScrollColumnCtx(ctx, (Rectangle){ 0, 0, 200, ID_ITEMS*(item_size + gap) }, 0, ID_ITEMS, item_size);
+    for (int i = 0; i < ID_ITEMS; i++)
+    {
+        GuiLayoutRecCtx(ctx, -1, -1);
+        ids[i] = GuiLayoutIdLastCtx(ctx);
+    }
+    GuiLayoutEndCtx(ctx);
+
+    RGLBeginFrameCtx(ctx);
+    float scroll = rng_float(0, ID_ITEMS*(item_size + gap));
+    RGLRange range = GuiBeginScrollColumnCtx(ctx, (Rectangle){ 0, 0, 200, rng_float(0, 400) }, scroll, ID_ITEMS, item_size);
+    for (int i = 0; i < range.count; i++)
+    {
+        GuiLayoutRecCtx(ctx, -1, -1);
+        unsigned int id = GuiLayoutIdLastCtx(ctx);
+        CHECK(id == ids[range.first + i], "scroll item %d has ID 0x%08x at offset %g, 0x%08x when unscrolled",
+            range.first + i, id, scroll, ids[range.first + i]);
+    }
+    GuiLayoutEndCtx(ctx);
+}
+
+// Sibling container IDs of one row, with a container the span stack cannot hold opened before them
+static void overflow_sibling_ids(RGLContext *ctx, const RGLPlan *huge, int kind, unsigned int *ids, int count)
+{
+    RGLBeginFrameCtx(ctx);
+    GuiBeginRowCtx(ctx, (Rectangle){ 0, 0, 800, 100 }, NULL);
+    if (kind == 1) GuiBeginRowCtx(ctx, (Rectangle){ 0, 0, 100, 100 }, huge);
+    if (kind == 2) GuiBeginGridCtx(ctx, (Rectangle){ 0, 0, 100, 100 }, huge, NULL);
+    if (kind != 0) GuiLayoutEndCtx(ctx);
+    for (int i = 0; i < count; i++)
+    {
+        GuiBeginColumnCtx(ctx, (Rectangle){ 120 + 20*(float)i, 0, 20, 100 }, NULL); // Not a Rec: IDs by sibling index
+        ids[i] = GuiLayoutIdCurrentCtx(ctx);
+        GuiLayoutEndCtx(ctx);
+    }
+    GuiLayoutEndCtx(ctx);
+    CHECK((RGLGetErrorsCtx(ctx) & RGL_ERROR_SPAN_OVERFLOW) == ((kind != 0)? RGL_ERROR_SPAN_OVERFLOW : 0),
+        "kind %d: errors 0x%x", kind, RGLGetErrorsCtx(ctx));
+}
+
+static void test_overflow_ids(void)
+{
+    static float entries[RGL_SPAN_MAX + 1];
+    RGLPlan huge = GuiPlanCreateBuffer(entries, RGL_SPAN_MAX + 1);
+    GuiPlanAddRepeat(&huge, -1, RGL_SPAN_MAX + 1);
+
+    RGLContext ctx; // No arena or allocator: spans cannot grow past the inline buffer
+    RGLInitContext(&ctx);
+
+    unsigned int plain[4], skipped[4];
+    int kind = rng_int(1, 2);
+    overflow_sibling_ids(&ctx, &huge, 0, plain, 4);
+    overflow_sibling_ids(&ctx, &huge, kind, skipped, 4);
+    for (int i = 0; i < 4; i++)
+        CHECK(plain[i] == skipped[i], "kind %d: sibling %d has ID 0x%08x after a skipped container, 0x%08x without",
+            kind, i, skipped[i], plain[i]);
+}
+
+//----------------------------------------------------------------------------------
+// Record & replay
+//----------------------------------------------------------------------------------
+
+// Batches in every kind of container, aligned by the recording context's default
+static void random_batches(RGLContext *ctx, Rectangle bounds)
+{
+    float out[4*16];
+    for (int i = 0; i < 4; i++)
+    {
+        RGLSetDefaultVAlignCtx(ctx, (RGLVAlign)rng_int(0, 3));
+        switch (rng_int(0, 2))
+        {
+        case 0: GuiBeginRowCtx(ctx, bounds, NULL); break;
+        case 1: GuiBeginColumnCtx(ctx, bounds, RGL_PLAN(-1, 40, 2)); break;
+        default: GuiBeginFlowCtx(ctx, bounds, 20); break;
+        }
+        int count = rng_int(1, 16);
+        GuiLayoutRecNCtx(ctx, count, rng_float(0, 60), rng_float(-1, 80), out, out + count, out + 2*count, out + 3*count);
+        GuiLayoutEndCtx(ctx);
+    }
+}
+
+static void test_replay(void)
+{
+    static unsigned char log_memory[1 << 20];
+    static unsigned char scratch_memory[1 << 16];
+    RGLRecorder recorder;
+    RGLArena scratch;
+    RGLRecorderInit(&recorder, log_memory, sizeof(log_memory));
+    RGLArenaInit(&scratch, scratch_memory, sizeof(scratch_memory));
+
+    RGLContext recording, fresh;
+    RGLInitContext(&recording);
+    RGLInitContext(&fresh);
+    RGLSetDefaultGapCtx(&recording, rng_float(0, 8));
+    RGLSetDefaultPadAllCtx(&recording, rng_float(0, 8));
+    RGLSetRecorderCtx(&recording, &recorder);
+
+    Rectangle screen = { 0, 0, rng_float(0, 1600), rng_float(0, 1000) };
+    for (int frame = 0; frame < 2; frame++)
+    {
+        RGLBeginFrameCtx(&recording);
+        random_container(&recording, screen, 0);
+        random_batches(&recording, (Rectangle){ 0, 0, screen.width, 100 });
+    }
+
+    RGLReplayResult result = RGLReplayCtx(&fresh, recorder.data, recorder.size, &scratch);
+    CHECK(!recorder.overflow, "recorder overflowed");
+    CHECK(result.valid && result.frames == 2, "replay invalid (%d frames)", result.frames);
+    CHECK(result.mismatches == 0, "%d of %d replayed rects differ, first at log offset %d",
+        result.mismatches, result.rects, (int)result.first_mismatch);
+}
+
+//----------------------------------------------------------------------------------
+// Incremental tree solve
+//----------------------------------------------------------------------------------
+
+static float random_request(void)
+{
+    switch (rng_int(0, 3))
+    {
+    case 0: return -1;
+    case 1: return RGL_FIT;
+    default: return rng_float(0, 120);
+    }
+}
+
+static void random_tree(RGLTree *tree, int depth)
+{
+    int children = rng_int(0, 6);
+    for (int i = 0; i < children; i++)
+    {
+        float main = random_request(), cross = random_request();
+        if (depth < 4 && rng_int(0, 2) == 0)
+        {
+            RGLPad pad = { rng_float(0, 8), rng_float(0, 8), rng_float(0, 8), rng_float(0, 8) };
+            if (rng_int(0, 1)) RGLTreeBeginRowEx(tree, main, cross, pad, rng_float(0, 6));
+            else RGLTreeBeginColumnEx(tree, main, cross, pad, rng_float(0, 6));
+            random_tree(tree, depth + 1);
+            RGLTreeEnd(tree);
+        }
+        else RGLTreeRecContent(tree, main, cross, rng_float(0, 80), rng_float(0, 40));
+    }
+}
+
+static void test_tree_resize(void)
+{
+    static RGLNode full_nodes[2048], incremental_nodes[2048];
+    RGLTree full, incremental;
+
+    RGLContext ctx; // Defaults come from an explicit context, not the thread's current one
+    RGLInitContext(&ctx);
+    RGLSetDefaultGapCtx(&ctx, (float)rng_int(0, 8));
+    RGLTreeBeginCtx(&ctx, &full, full_nodes, 2048);
+    CHECK(full.default_gap == ctx.default_gap, "tree gap %g, context gap %g", full.default_gap, ctx.default_gap);
+    RGLTreeBeginColumn(&full, -1, -1);
+    random_tree(&full, 0);
+    RGLTreeEnd(&full);
+    if (rng_int(0, 1)) random_tree(&full, 3); // Extra roots
+
+    incremental = full;
+    incremental.nodes = incremental_nodes;
+    memcpy(incremental_nodes, full_nodes, full.count*sizeof(RGLNode));
+
+    Rectangle bounds = { 0, 0, rng_float(0, 1600), rng_float(0, 1000) };
+    CHECK(RGLTreeSolveIncremental(&incremental, bounds) == full.count, "first incremental solve is not a full solve");
+    for (int step = 0; step < 8; step++)
+    {
+        // Drag resizes mostly change one edge, sometimes nothing or everything
+        switch (rng_int(0, 3))
+        {
+        case 0: bounds.width = rng_float(0, 1600); break;
+        case 1: bounds.height = rng_float(0, 1000); break;
+        case 2: break;
+        default: bounds = (Rectangle){ rng_float(-50, 50), rng_float(-50, 50), rng_float(0, 1600), rng_float(0, 1000) }; break;
+        }
+
+        RGLTreeSolve(&full, bounds);
+        int placed = RGLTreeSolveIncremental(&incremental, bounds);
+        CHECK(placed <= full.count, "%d nodes placed, tree has %d", placed, full.count);
+        for (int i = 0; i < full.count; i++)
+        {
+            Rectangle a = full_nodes[i].rect, b = incremental_nodes[i].rect;
+            if (a.x != b.x || a.y != b.y || a.width != b.width || a.height != b.height)
+            {
+                CHECK(false, "node %d is {%g, %g, %g, %g} after an incremental solve, full solve {%g, %g, %g, %g}",
+                    i, b.x, b.y, b.width, b.height, a.x, a.y, a.width, a.height);
+                break;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Responsive plans
+//----------------------------------------------------------------------------------
+
+// Reference selection: the first entry with the largest min_width not above width, else the first smallest
+static int expected_breakpoint(const RGLBreakpoint *table, int count, float width)
+{
+    int selected = -1, lowest = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (table[i].min_width < table[lowest].min_width) lowest = i;
+        if (table[i].min_width <= width && (selected < 0 || table[i].min_width > table[selected].min_width)) selected = i;
+    }
+    return (selected >= 0)? selected : lowest;
+}
+
+static void test_responsive(void)
+{
+    static RGLLayoutCache cache; // Tables are matched by address, a rewritten table needs a reset
+    RGLLayoutCacheReset(&cache);
+
+    RGLPlan plans[4];
+    RGLBreakpoint table[4];
+    int count = rng_int(1, 4);
+    for (int i = 0; i < count; i++)
+    {
+        plans[i] = random_plan(rng_int(1, 12), 300, 4);
+        table[i] = (RGLBreakpoint){ (float)rng_int(0, 8)*100, (rng_int(0, 7) == 0)? NULL : &plans[i] };
+    }
+
+    RGLContext cached, reference;
+    RGLInitContext(&cached);
+    RGLInitContext(&reference);
+    RGLSetDefaultGapCtx(&cached, 4);
+    RGLSetDefaultGapCtx(&reference, 4);
+    RGLSetLayoutCacheCtx(&cached, &cache);
+
+    bool row = rng_int(0, 1);
+    float width = rng_float(0, 1000);
+    for (int frame = 0; frame < 16; frame++)
+    {
+        bool steady = (frame > 0);
+        if (rng_int(0, 2) == 0) { width = rng_float(0, 1000); steady = false; } // Steady frames in between
+        Rectangle bounds = { 0, 0, width, 300 };
+        const RGLPlan *plan = table[expected_breakpoint(table, count, width)].plan;
+        unsigned int misses = cache.misses;
+
+        RGLBeginFrameCtx(&cached);
+        RGLBeginFrameCtx(&reference);
+        GuiLayoutSetNextIdCtx(&cached, 42);
+        if (row)
+        {
+            GuiBeginRowResponsiveCtx(&cached, bounds, table, count);
+            GuiBeginRowCtx(&reference, bounds, plan);
+        }
+        else
+        {
+            GuiBeginColumnResponsiveCtx(&cached, bounds, table, count);
+            GuiBeginColumnCtx(&reference, bounds, plan);
+        }
+        CHECK(!steady || plan == NULL || cache.misses == misses, "frame %d, width %g: steady frame was resolved again", frame, width);
+
+        int children = (plan != NULL)? plan->length : 3;
+        for (int i = 0; i < children; i++)
+        {
+            Rectangle a = GuiLayoutRecCtx(&cached, -1, -1), b = GuiLayoutRecCtx(&reference, -1, -1);
+            if (a.x != b.x || a.y != b.y || a.width != b.width || a.height != b.height)
+            {
+                CHECK(false, "frame %d, width %g: child %d is {%g, %g, %g, %g}, expected {%g, %g, %g, %g}",
+                    frame, width, i, a.x, a.y, a.width, a.height, b.x, b.y, b.width, b.height);
+                break;
+            }
+        }
+        GuiLayoutEndCtx(&cached);
+        GuiLayoutEndCtx(&reference);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Hand-filled plans
+//----------------------------------------------------------------------------------
+
+static bool same_plan_rects(RGLContext *ctx, const RGLPlan *a, const RGLPlan *b, bool grid)
+{
+    Rectangle bounds = { 10, 20, 500, 300 };
+    Rectangle ra[RGL_PLAN_MAX*RGL_PLAN_MAX], rb[RGL_PLAN_MAX*RGL_PLAN_MAX];
+    int capacity = RGL_PLAN_MAX*RGL_PLAN_MAX;
+
+    if (grid) GuiBeginGridCtx(ctx, bounds, a, a); else GuiBeginRowCtx(ctx, bounds, a);
+    int na = GuiLayoutPlanRecsCtx(ctx, ra, capacity);
+    GuiLayoutEndCtx(ctx);
+    if (grid) GuiBeginGridCtx(ctx, bounds, b, b); else GuiBeginRowCtx(ctx, bounds, b);
+    int nb = GuiLayoutPlanRecsCtx(ctx, rb, capacity);
+    GuiLayoutEndCtx(ctx);
+
+    return na == nb && memcmp(ra, rb, (size_t)na*sizeof(Rectangle)) == 0;
+}
+
+static void test_hand_plans(RGLContext *ctx)
+{
+    RGLPlan built = random_plan(rng_int(1, 12), 300, 4);
+
+    RGLPlan hand;
+    memset(&hand, 0, sizeof(hand));
+    memcpy(hand.sizes, built.sizes, (size_t)built.length*sizeof(float));
+    hand.length = built.length;
+
+    RGLBeginFrameCtx(ctx);
+    CHECK(same_plan_rects(ctx, &hand, &built, false), "hand-filled row plan of %d entries differs", built.length);
+    CHECK(same_plan_rects(ctx, &hand, &built, true), "hand-filled grid plan of %d entries differs", built.length);
+
+    // Direct edit of a built plan, then refresh
+    RGLPlan edited = built;
+    edited.sizes[rng_int(0, built.length - 1)] = (float)rng_int(1, 60);
+    GuiPlanRefresh(&edited);
+    RGLPlan rebuilt = GuiPlanCreate(edited.sizes, edited.length);
+    CHECK(edited.sum_fixed == rebuilt.sum_fixed && edited.sum_weight == rebuilt.sum_weight && edited.hash == rebuilt.hash,
+        "refreshed plan totals {%g, %g, %u}, rebuilt {%g, %g, %u}",
+        edited.sum_fixed, edited.sum_weight, edited.hash, rebuilt.sum_fixed, rebuilt.sum_weight, rebuilt.hash);
+    CHECK(same_plan_rects(ctx, &edited, &rebuilt, false), "refreshed plan differs from its rebuild");
+}
+
+static void test_plan_reuse(RGLContext *ctx)
+{
+    RGLPlan plan = GuiPlanCreate(NULL, 0);
+    for (int frame = 0; frame < 8; frame++)
+    {
+        plan.length = 0; // Rebuilt in place every frame
+        RGLPlan fresh = GuiPlanCreate(NULL, 0);
+        int length = rng_int(1, 12);
+        for (int i = 0; i < length; i++)
+        {
+            RGLPlan entry = random_plan(1, 300, 0);
+            int repeat = (rng_int(0, 3) == 0)? 2 : 1;
+            GuiPlanAddRepeat(&plan, entry.sizes[0], repeat);
+            GuiPlanAddRepeat(&fresh, entry.sizes[0], repeat);
+        }
+
+        CHECK(plan.sum_fixed == fresh.sum_fixed && plan.sum_weight == fresh.sum_weight && plan.hash == fresh.hash,
+            "frame %d: reused plan totals {%g, %g, %u}, fresh {%g, %g, %u}",
+            frame, plan.sum_fixed, plan.sum_weight, plan.hash, fresh.sum_fixed, fresh.sum_weight, fresh.hash);
+        RGLBeginFrameCtx(ctx);
+        CHECK(same_plan_rects(ctx, &plan, &fresh, false), "frame %d: reused plan of %d entries differs", frame, plan.length);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Layout cache
+//----------------------------------------------------------------------------------
+
+// Open the same container on a cached and an uncached context, children may nest further
+static void cached_pair(RGLContext *cached, RGLContext *reference, Rectangle bounds, const RGLPlan *plans, int depth)
+{
+    const RGLPlan *plan = &plans[rng_int(0, 3)];
+    bool row = rng_int(0, 1);
+
+    GuiLayoutSetNextIdCtx(cached, (unsigned int)rng_int(1, 3)); // Few IDs: some are reused while open
+    if (row)
+    {
+        GuiBeginRowCtx(cached, bounds, plan);
+        GuiBeginRowCtx(reference, bounds, plan);
+    }
+    else
+    {
+        GuiBeginColumnCtx(cached, bounds, plan);
+        GuiBeginColumnCtx(reference, bounds, plan);
+    }
+
+    Rectangle a[RGL_PLAN_MAX], b[RGL_PLAN_MAX];
+    int count = GuiLayoutPlanRecsCtx(cached, a, RGL_PLAN_MAX);
+    CHECK(count == GuiLayoutPlanRecsCtx(reference, b, RGL_PLAN_MAX) && memcmp(a, b, (size_t)count*sizeof(Rectangle)) == 0,
+        "depth %d: planned rects differ", depth);
+
+    for (int i = 0; i < plan->length; i++)
+    {
+        Rectangle x = GuiLayoutRecCtx(cached, -1, -1), y = GuiLayoutRecCtx(reference, -1, -1);
+        if (x.x != y.x || x.y != y.y || x.width != y.width || x.height != y.height)
+        {
+            CHECK(false, "depth %d: child %d is {%g, %g, %g, %g}, expected {%g, %g, %g, %g}",
+                depth, i, x.x, x.y, x.width, x.height, y.x, y.y, y.width, y.height);
+            break;
+        }
+        if (depth < 2 && rng_int(0, 3) == 0)
+            cached_pair(cached, reference, x, plans, depth + 1);
+    }
+    GuiLayoutEndCtx(cached);
+    GuiLayoutEndCtx(reference);
+}
+
+static void test_cache(void)
+{
+    static RGLLayoutCache cache;
+    RGLLayoutCacheReset(&cache);
+
+    RGLPlan plans[4];
+    for (int i = 0; i < 4; i++)
+        plans[i] = random_plan(rng_int(1, 12), 300, 4);
+
+    RGLContext cached, reference;
+    RGLInitContext(&cached);
+    RGLInitContext(&reference);
+    RGLSetDefaultGapCtx(&cached, 4);
+    RGLSetDefaultGapCtx(&reference, 4);
+    RGLSetLayoutCacheCtx(&cached, &cache);
+
+    Rectangle bounds = { 0, 0, 600, 400 };
+    for (int frame = 0; frame < 16; frame++)
+    {
+        int change = rng_int(0, 5); // Steady frames in between
+        if (change == 0) bounds.width = rng_float(100, 800);
+        if (change == 1) plans[rng_int(0, 3)] = random_plan(rng_int(1, 12), 300, 4);
+        if (change == 2) GuiPlanAdd(&plans[rng_int(0, 3)], (float)rng_int(1, 4));
+        if (change == 3)
+        {
+            // Same entries in reverse: length and totals match, only the hash tells them apart
+            RGLPlan *plan = &plans[rng_int(0, 3)];
+            float reversed[RGL_PLAN_MAX];
+            for (int i = 0; i < plan->length; i++)
+                reversed[i] = plan->sizes[plan->length - 1 - i];
+            bool palindrome = (memcmp(reversed, plan->sizes, (size_t)plan->length*sizeof(float)) == 0);
+            unsigned int hash = plan->hash;
+            *plan = GuiPlanCreate(reversed, plan->length);
+            CHECK(palindrome || plan->hash != hash, "reversed plan of %d entries keeps hash %u", plan->length, hash);
+        }
+
+        unsigned int state = g_rng; // Same frame twice: the second one replays from the cache
+        for (int pass = 0; pass < 2; pass++)
+        {
+            g_rng = state;
+            RGLBeginFrameCtx(&cached);
+            RGLBeginFrameCtx(&reference);
+            cached_pair(&cached, &reference, bounds, plans, 0);
+        }
+    }
+    CHECK(cache.hits > 0, "no cache hits in %u lookups", cache.misses);
+
+    // Compile-time plans hash like built ones, so both share cache entries
+    RGLPlan literal = RGL_PLAN_INIT(-1, 120, 2.5f, 0, 40);
+    RGLPlan built = GuiPlanCreate((const float[]){ -1, 120, 2.5f, 0, 40 }, 5);
+    CHECK(literal.hash == built.hash, "plan hash %u, built %u", literal.hash, built.hash);
+}
+
+int main(int argc, char **argv)
+{
+    int seeds = (argc > 1)? atoi(argv[1]) : 500;
+    if (seeds <= 0) seeds = 1;
+
+    static unsigned char arena_memory[1 << 16];
+    RGLArena arena;
+    RGLArenaInit(&arena, arena_memory, sizeof(arena_memory));
+
+    // Begin/Rec touch one container per call, keep it to one cache line
+    CHECK(sizeof(RGLContainer) <= 64, "sizeof(RGLContainer) is %d bytes", (int)sizeof(RGLContainer));
+
+    for (int s = 0; s < seeds; s++)
+    {
+        g_seed = (unsigned int)s;
+        g_rng = 0x9e3779b9u ^ (unsigned int)(s*2654435761u);
+        if (g_rng == 0) g_rng = 1;
+
+        RGLContext ctx;
+        RGLInitContext(&ctx);
+        test_layout_properties(&ctx);
+        test_balance(&ctx, false);
+
+        RGLSetArenaCtx(&ctx, &arena);
+        test_layout_properties(&ctx);
+        test_balance(&ctx, true);
+        test_item_ids(&ctx);
+        test_hand_plans(&ctx);
+        test_plan_reuse(&ctx);
+
+        test_overflow_ids();
+        test_replay();
+        test_tree_resize();
+        test_responsive();
+        test_cache();
+    }
+
+    printf("%d seeds: %s (%d failures)\n", seeds, (g_failures == 0)? "ok" : "FAILED", g_failures);
+    return (g_failures == 0)? 0 : 1;
+}